@@ -36,11 +36,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/static_assert.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/limits.hpp>
+#include <cstddef>
 #include <cstring>
 #include "detail/aes_config.hpp"
 #include "detail/aes_impl.hpp"
 #include "detail/aes_common.hpp"
 #include "detail/aes_hasaesni.hpp"
+#include "detail/aes_blocks.hpp"
+#include "detail/prf_range.hpp"
 
 namespace boost{
 namespace random{
@@ -85,6 +88,11 @@ struct aes : public detail::aes_common<Uint>{
             detail::hw128 c128; c128 = c;
             return static_cast<_range_type>(apply(c128));
         }else
+#elif BOOST_HAS_AESNI_DISPATCH
+        if( this->useAESNI ){
+            detail::aes_blocks<10>(&xkey.sw[0], &c, 1);
+            return c;
+        }else
 #endif
         {
             detail::sw128 c128; c128 = c;
@@ -92,6 +100,25 @@ struct aes : public detail::aes_common<Uint>{
         }
     }
 
+    // As for ars:  out[i] is the value at the i-th counter from c,
+    // counting in the given word.
+    void operator()(_domain_type c, _range_type* out, std::size_t n, std::size_t word = 0){
+#if BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
+        if( this->useAESNI ){
+            BOOST_STATIC_ASSERT(sizeof(_range_type) == 16);
+            detail::prf_fill(c, out, n, word);
+            // The hardware and software expanded keys have the same
+            // bytes, as xkeycopy assumes.
+            detail::aes_blocks<10>(&xkey.sw[0], out, n);
+            return;
+        }
+#endif
+        for(std::size_t i=0; i<n; ++i){
+            out[i] = (*this)(c);
+            detail::prf_incr(c, word);
+        }
+    }
+
 protected:
 #if BOOST_HAS_AESNI    
     detail::hw128&
@@ -173,6 +200,13 @@ protected:
 
 };
 
+namespace detail{
+template <typename Uint>
+struct has_prf_range<aes<Uint> >{
+    static const bool value = true;
+};
+} // namespace detail
+
 } // namespace random
 } // namespace boost
 
@@ -36,11 +36,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/static_assert.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/limits.hpp>
+#include <cstddef>
 #include <cstring>
 #include "detail/aes_config.hpp"
 #include "detail/aes_impl.hpp"
 #include "detail/aes_common.hpp"
 #include "detail/aes_hasaesni.hpp"
+#include "detail/aes_blocks.hpp"
+#include "detail/prf_range.hpp"
 
 namespace boost{
 namespace random{
@@ -84,6 +87,11 @@ struct ars : public detail::aes_common<Uint>{
             detail::hw128 k128; k128 = this->k;
             return static_cast<_range_type>(apply(c128, k128));
         }else
+#elif BOOST_HAS_AESNI_DISPATCH
+        if( this->useAESNI ){
+            blocks(&c, 1);
+            return c;
+        }else
 #endif
         {
             detail::sw128 c128; c128 = c;
@@ -92,7 +100,41 @@ struct ars : public detail::aes_common<Uint>{
         }
     }
 
+    // Evaluate the n consecutive counters c, c+1, ..., c+n-1 into
+    // out[0], ..., out[n-1], counting in the given word as
+    // detail::prf_incr does.  With AES-NI the counters are encrypted
+    // several at a time by detail::aes_blocks.
+    void operator()(_domain_type c, _range_type* out, std::size_t n, std::size_t word = 0){
+#if BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
+        if( this->useAESNI ){
+            detail::prf_fill(c, out, n, word);
+            blocks(out, n);
+            return;
+        }
+#endif
+        for(std::size_t i=0; i<n; ++i){
+            out[i] = (*this)(c);
+            detail::prf_incr(c, word);
+        }
+    }
+
 protected:
+#if BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
+    // Encrypt p[0], ..., p[n-1] in place with AES-NI.  The round keys
+    // are the key plus 0, 1, ..., R times the Weyl increment.
+    void blocks(_range_type* p, std::size_t n){
+        BOOST_STATIC_ASSERT(sizeof(_range_type) == 16);
+        detail::sw128 w128; w128 = std::make_pair(CONSTANTS::W0, CONSTANTS::W1);
+        detail::sw128 rk[R+1];
+        rk[0] = this->k;
+        for(unsigned r=1; r<=R; ++r){
+            rk[r] = rk[r-1];
+            rk[r] += w128;
+        }
+        detail::aes_blocks<R>(rk, p, n);
+    }
+#endif
+
 #if BOOST_HAS_AESNI
     detail::hw128&
     apply(detail::hw128& c128, detail::hw128 k128){
@@ -127,6 +169,13 @@ ars<Uint, R, CONSTANTS>::apply(detail::sw128& c128, detail::sw128 k128){
     return aesenclast(c128, k128);
 }
 
+namespace detail{
+template <typename Uint, unsigned R, typename CONSTANTS>
+struct has_prf_range<ars<Uint, R, CONSTANTS> >{
+    static const bool value = true;
+};
+} // namespace detail
+
 } // namespace random
 } // namespace boost
 
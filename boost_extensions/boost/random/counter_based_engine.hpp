@@ -40,8 +40,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/random/detail/operators.hpp>
 #include <boost/random/detail/seed.hpp>
 #include <boost/random/detail/integer_log2.hpp> // for BOOST_RANDOM_DETAIL_CONSTEXPR
+#include <boost/random/detail/prf_range.hpp>
 
 #include <iosfwd>
+#include <iterator>
 #include <utility>
 #include <stdexcept>
 
@@ -262,9 +264,44 @@ public:
         setnext(newnth);
     }
          
+    // Fills [first, last) with 32-bit words as detail::generate_from_int
+    // does, but the whole blocks in the middle are encrypted straight from
+    // their counters, in chunks, with the PRF's own range evaluation if it
+    // has one.  Leaves *this where the word at a time version would.
     template <class Iter>
-    void generate(Iter first, Iter last)
-    { detail::generate_from_int(*this, first, last); }
+    void generate(Iter first, Iter last){
+        typedef detail::prf_words<result_type> words;
+        if(!words::whole){
+            detail::generate_from_int(*this, first, last);
+            return;
+        }
+        if(first == last)
+            return;
+        // the rest of the current block
+        while(next != v.end())
+            if(!words::put(*next++, first, last))
+                return;
+
+        static const size_t chunk = 64;
+        range_type buf[chunk];
+        boost::uintmax_t blocks = std::distance(first, last) / (v.size() * words::words);
+        while(blocks){
+            size_t m = blocks < chunk ? static_cast<size_t>(blocks) : chunk;
+            domain_type start = c;
+            // throws, before the chunk is written, if the counters run out
+            incr(m);
+            detail::prf_incr(start);
+            detail::prf_range(b, start, buf, m);
+            for(size_t i=0; i<m; ++i)
+                for(typename range_type::const_iterator p=buf[i].begin(); p!=buf[i].end(); ++p)
+                    words::put(*p, first, last);
+            blocks -= m;
+        }
+
+        // fewer words than a block holds
+        while(first != last)
+            words::put((*this)(), first, last);
+    }
 
     //--------------------------
     // Some bonus methods, not required for a Random Number
@@ -0,0 +1,219 @@
+/** @page LICENSE
+Copyright 2026, agent <agent@local>.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+* Redistributions of source code must retain the above copyright
+  notice, this list of conditions, and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions, and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BOOST_RANDOM_COUNTER_BASED_RANDOM_ACCESS_HPP
+#define BOOST_RANDOM_COUNTER_BASED_RANDOM_ACCESS_HPP
+
+#include <boost/cstdint.hpp>
+#include <boost/limits.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/random/detail/prf_range.hpp>
+#include <cstddef>
+#include <stdexcept>
+
+namespace boost{
+namespace random{
+
+// counter_based_random_access gives the random values of a Monte
+// Carlo simulation by their coordinates, rather than as a sequence:
+// the value for (stream, path, step, dimension) is computed on its own
+// in O(1), with no state beyond the key.  So any single path can be
+// recomputed on demand, e.g. to bump it for a pathwise Greek or to
+// replay it for an audit, without storing its random numbers.
+//
+// The stream is the key of the PRF, and the other coordinates are laid
+// out in its 128-bit counter as follows, from the least significant
+// bit:
+//
+//     bits   0-31   block:  dimension / values_per_block
+//     bits  32-63   step
+//     bits  64-127  path
+//
+// Each PRF evaluation gives values_per_block values, for consecutive
+// dimensions.  So there are 2^64 paths of 2^32 steps, each with up to
+// 2^32 * values_per_block dimensions.  A step or dimension beyond that
+// throws std::out_of_range, rather than aliasing another coordinate.
+// Prf must have a 128-bit counter:  philox<4, uint32_t>,
+// philox<2, uint64_t>, threefry<4, uint32_t>, threefry<2, uint64_t>,
+// ars<uint32_t> or aes<uint32_t>, say.
+template<typename Prf>
+class counter_based_random_access{
+public:
+    typedef Prf prf_type;
+    typedef typename prf_type::key_type key_type;
+    typedef typename prf_type::domain_type domain_type;
+    typedef typename prf_type::range_type range_type;
+    typedef typename range_type::value_type result_type;
+
+    BOOST_STATIC_CONSTANT(unsigned, block_bits = 32);
+    BOOST_STATIC_CONSTANT(unsigned, step_bits = 32);
+    BOOST_STATIC_CONSTANT(unsigned, path_bits = 64);
+    BOOST_STATIC_CONSTANT(std::size_t, values_per_block = range_type::static_size);
+
+private:
+    typedef typename domain_type::value_type dvalue_type;
+    typedef typename key_type::value_type kvalue_type;
+    BOOST_STATIC_CONSTANT(int, dvalue_bits = std::numeric_limits<dvalue_type>::digits);
+    BOOST_STATIC_CONSTANT(int, kvalue_bits = std::numeric_limits<kvalue_type>::digits);
+    BOOST_STATIC_ASSERT(dvalue_bits == 32 || dvalue_bits == 64);
+    BOOST_STATIC_ASSERT(dvalue_bits * domain_type::static_size == 128);
+    BOOST_STATIC_ASSERT(kvalue_bits % 32 == 0 && kvalue_bits * key_type::static_size >= 64);
+    BOOST_STATIC_ASSERT(std::numeric_limits<result_type>::digits % 32 == 0);
+
+public:
+    // The stream with the given key.
+    explicit counter_based_random_access(const key_type& k) : b(k){
+    }
+
+    // The stream with the given number, which is put in the low 64
+    // bits of the key, the rest of which is 0.
+    explicit counter_based_random_access(boost::uint64_t stream) : b(stream_key(stream)){
+    }
+
+    static key_type stream_key(boost::uint64_t stream){
+        key_type k = {{}};
+        for(std::size_t j=0; j<k.size() && j*kvalue_bits<64; ++j){
+            k[j] = static_cast<kvalue_type>(stream);
+            stream >>= kvalue_bits/2;
+            stream >>= kvalue_bits/2;
+        }
+        return k;
+    }
+
+    key_type getkey() const{
+        return b.getkey();
+    }
+
+    // The counter of the given block.
+    static domain_type counter(boost::uint64_t path, boost::uint64_t step, boost::uint64_t blk){
+        if(step >> step_bits)
+            throw std::out_of_range("counter_based_random_access: step out of range");
+        if(blk >> block_bits)
+            throw std::out_of_range("counter_based_random_access: dimension out of range");
+        domain_type c;
+        if(dvalue_bits == 32){
+            c[0] = static_cast<dvalue_type>(blk);
+            c[1] = static_cast<dvalue_type>(step);
+            c[2 % domain_type::static_size] = static_cast<dvalue_type>(path);
+            c[3 % domain_type::static_size] = static_cast<dvalue_type>(path >> 32);
+        }else{
+            c[0] = static_cast<dvalue_type>(blk | step << 32);
+            c[1] = static_cast<dvalue_type>(path);
+        }
+        return c;
+    }
+
+    // The values for the dimensions blk*values_per_block, ...,
+    // (blk+1)*values_per_block - 1.
+    range_type block(boost::uint64_t path, boost::uint64_t step, boost::uint64_t blk) const{
+        return b(counter(path, step, blk));
+    }
+
+    // The value for one dimension.
+    result_type operator()(boost::uint64_t path, boost::uint64_t step, boost::uint64_t dimension) const{
+        return block(path, step, dimension / values_per_block)[dimension % values_per_block];
+    }
+
+    // The value for one dimension as a double in (0, 1):  its leading 52
+    // bits (all 32 for 32-bit values) are the binary digits of the
+    // double, after which there is a 1.  So 0 and 1 never occur, and the
+    // doubles are symmetric about 1/2, as wanted for inversion of a cdf.
+    // The double is exact, so it does not depend on the precision of
+    // intermediate results (x87).
+    double uniform(boost::uint64_t path, boost::uint64_t step, boost::uint64_t dimension) const{
+        return to_uniform((*this)(path, step, dimension));
+    }
+
+    // The values for the n dimensions first, ..., first+n-1, in out[0],
+    // ..., out[n-1], evaluating the blocks several at a time.
+    void operator()(boost::uint64_t path, boost::uint64_t step, boost::uint64_t first,
+                    result_type* out, std::size_t n) const{
+        fill(path, step, first, out, n, identity());
+    }
+
+    // As uniform(), for the n dimensions first, ..., first+n-1.
+    void uniforms(boost::uint64_t path, boost::uint64_t step, boost::uint64_t first,
+                  double* out, std::size_t n) const{
+        fill(path, step, first, out, n, to_double());
+    }
+
+    static double to_uniform(result_type x){
+        static const int digits = std::numeric_limits<result_type>::digits;
+        static const int bits = digits < 52 ? digits : 52;
+        // 2^-bits, as a product of exact powers of 2
+        static const double scale = 1.0 / 4294967296.0 * (bits == 32 ? 1.0 : 1.0 / 1048576.0);
+        return (static_cast<double>(x >> (digits - bits)) + 0.5) * scale;
+    }
+
+private:
+    struct identity{
+        result_type operator()(result_type x) const{ return x; }
+    };
+    struct to_double{
+        double operator()(result_type x) const{ return to_uniform(x); }
+    };
+
+    template <typename T, typename Convert>
+    void fill(boost::uint64_t path, boost::uint64_t step, boost::uint64_t first,
+              T* out, std::size_t n, Convert convert) const{
+        if(n == 0)
+            return;
+        if(first + (n - 1) < first)
+            throw std::out_of_range("counter_based_random_access: dimension out of range");
+        boost::uint64_t blk = first / values_per_block;
+        const boost::uint64_t last = (first + (n - 1)) / values_per_block;
+        // checks that the last block is in range, so that counting in
+        // the lowest word never carries out of the block field
+        counter(path, step, last);
+
+        static const std::size_t chunk = 64;
+        range_type buf[chunk];
+        std::size_t j = first % values_per_block, i = 0;
+        while(blk <= last){
+            const std::size_t m = last - blk + 1 < chunk ? static_cast<std::size_t>(last - blk + 1) : chunk;
+            detail::prf_range(b, counter(path, step, blk), buf, m);
+            for(std::size_t k=0; k<m; ++k){
+                for(; j<values_per_block && i<n; ++j)
+                    out[i++] = convert(buf[k][j]);
+                j = 0;
+            }
+            blk += m;
+        }
+    }
+
+    // the PRFs' operator() is not const, but does not change the PRF
+    mutable prf_type b;
+};
+
+} // namespace random
+} // namespace boost
+
+#endif // BOOST_RANDOM_COUNTER_BASED_RANDOM_ACCESS_HPP
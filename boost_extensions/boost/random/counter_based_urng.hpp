@@ -40,6 +40,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/random/detail/seed_impl.hpp>
 #include <boost/random/detail/signed_unsigned_tools.hpp>
 #include <boost/random/detail/integer_log2.hpp>
+#include <boost/random/detail/prf_range.hpp>
+#include <iterator>
 
 namespace boost{
 namespace random{
@@ -84,9 +86,51 @@ public:
     BOOST_RANDOM_DETAIL_CONSTEXPR static result_type min BOOST_PREVENT_MACRO_SUBSTITUTION () { return Prf::range_array_min(); }
     BOOST_RANDOM_DETAIL_CONSTEXPR static result_type max BOOST_PREVENT_MACRO_SUBSTITUTION () { return Prf::range_array_max(); }
 
+    // Fills [first, last) with 32-bit words as detail::generate_from_int
+    // does, but the whole blocks in the middle are encrypted straight from
+    // their counters, in chunks, with the PRF's own range evaluation if it
+    // has one.  Leaves *this where the word at a time version would.
     template <class Iter>
-    void generate(Iter first, Iter last)
-    { detail::generate_from_int(*this, first, last); }
+    void generate(Iter first, Iter last){
+        typedef detail::prf_words<result_type> words;
+        if(!words::whole){
+            detail::generate_from_int(*this, first, last);
+            return;
+        }
+        if(first == last)
+            return;
+        // the rest of the current block
+        while(next != rdata.end())
+            if(!words::put(*next++, first, last))
+                return;
+
+        static const size_t chunk = 64;
+        typename prf_type::range_type buf[chunk];
+        boost::uintmax_t blocks = std::distance(first, last) / (rdata.size() * words::words);
+        while(blocks){
+            size_t m = blocks < chunk ? static_cast<size_t>(blocks) : chunk;
+            domain_type start = c;
+            start.back() += delta();
+            if(delta() == 1){
+                // the counters count in the last word
+                detail::prf_range(b, start, buf, m, start.size()-1);
+            }else{
+                for(size_t i=0; i<m; ++i){
+                    buf[i] = b(start);
+                    start.back() += delta();
+                }
+            }
+            c.back() += m*delta();
+            for(size_t i=0; i<m; ++i)
+                for(typename prf_type::range_type::const_iterator p=buf[i].begin(); p!=buf[i].end(); ++p)
+                    words::put(*p, first, last);
+            blocks -= m;
+        }
+
+        // fewer words than a block holds
+        while(first != last)
+            words::put((*this)(), first, last);
+    }
 
     // N.B.  URNGs aren't *required* to have ==, !=, << or >>
     // operators, but they're trivial to implement, so we might
@@ -0,0 +1,131 @@
+/** @page LICENSE
+Copyright 2026, agent <agent@local>.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+* Redistributions of source code must retain the above copyright
+  notice, this list of conditions, and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions, and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BOOST_RANDOM_DETAIL_AES_BLOCKS_HPP
+#define BOOST_RANDOM_DETAIL_AES_BLOCKS_HPP
+
+// Encryption of many 128-bit blocks with AES-NI, for the evaluation of
+// ars and aes on ranges of counters.  aesenc has a latency of several
+// cycles but issues every cycle, and the rounds of one block depend on
+// each other, so the blocks are encrypted eight at a time, round by
+// round, keeping eight in flight.  Where the processor has VAES, sixteen
+// are encrypted at a time, four to an AVX-512 register.
+//
+// The functions are compiled for AES-NI (and VAES) by target
+// attributes, so that they may be called from code compiled without
+// -maes, after hasAESNI() (and hasVAES()) has been checked at run time.
+
+#include <boost/random/detail/aes_config.hpp>
+#include <boost/random/detail/aes_hasaesni.hpp>
+#include <boost/random/detail/aes_impl.hpp>
+#include <cstddef>
+
+#if BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
+#include <immintrin.h>
+
+namespace boost{
+namespace random{
+namespace detail{
+
+// Encrypt the 16-byte blocks p[0], ..., p[n-1] in place with the round
+// keys rk[0], ..., rk[Rounds]:  xor with rk[0], Rounds-1 aesenc and an
+// aesenclast.
+template <unsigned Rounds>
+BOOST_RANDOM_DETAIL_AESNI_TARGET
+inline void aesni_blocks(const sw128* rk, void* p, std::size_t n){
+    __m128i k[Rounds+1];
+    for(unsigned r=0; r<=Rounds; ++r)
+        k[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&rk[r]));
+    __m128i* b = static_cast<__m128i*>(p);
+    std::size_t i=0;
+    for(; i+8<=n; i+=8){
+        __m128i x[8];
+        for(int j=0; j<8; ++j)
+            x[j] = _mm_xor_si128(_mm_loadu_si128(b+i+j), k[0]);
+        for(unsigned r=1; r<Rounds; ++r)
+            for(int j=0; j<8; ++j)
+                x[j] = _mm_aesenc_si128(x[j], k[r]);
+        for(int j=0; j<8; ++j)
+            _mm_storeu_si128(b+i+j, _mm_aesenclast_si128(x[j], k[Rounds]));
+    }
+    for(; i<n; ++i){
+        __m128i x = _mm_xor_si128(_mm_loadu_si128(b+i), k[0]);
+        for(unsigned r=1; r<Rounds; ++r)
+            x = _mm_aesenc_si128(x, k[r]);
+        _mm_storeu_si128(b+i, _mm_aesenclast_si128(x, k[Rounds]));
+    }
+}
+
+#if BOOST_HAS_VAES_DISPATCH
+// As aesni_blocks, sixteen blocks at a time with VAES.  Returns the
+// number of blocks encrypted, n rounded down to a multiple of 16.
+template <unsigned Rounds>
+BOOST_RANDOM_DETAIL_VAES_TARGET
+inline std::size_t vaes_blocks(const sw128* rk, void* p, std::size_t n){
+    __m512i k[Rounds+1];
+    for(unsigned r=0; r<=Rounds; ++r)
+        k[r] = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&rk[r])));
+    __m512i* b = static_cast<__m512i*>(p);
+    std::size_t i=0;
+    for(; i+16<=n; i+=16){
+        __m512i* q = b + i/4;
+        __m512i x[4];
+        for(int j=0; j<4; ++j)
+            x[j] = _mm512_xor_si512(_mm512_loadu_si512(q+j), k[0]);
+        for(unsigned r=1; r<Rounds; ++r)
+            for(int j=0; j<4; ++j)
+                x[j] = _mm512_aesenc_epi128(x[j], k[r]);
+        for(int j=0; j<4; ++j)
+            _mm512_storeu_si512(q+j, _mm512_aesenclast_epi128(x[j], k[Rounds]));
+    }
+    return i;
+}
+#endif
+
+// Encrypt p[0], ..., p[n-1] in place as aesni_blocks does, with VAES if
+// the processor has it.  The caller must have checked hasAESNI().
+template <unsigned Rounds>
+inline void aes_blocks(const sw128* rk, void* p, std::size_t n){
+    std::size_t i = 0;
+#if BOOST_HAS_VAES_DISPATCH
+    if( n >= 16 && hasVAES() )
+        i = vaes_blocks<Rounds>(rk, p, n);
+#endif
+    aesni_blocks<Rounds>(rk, static_cast<__m128i*>(p) + i, n - i);
+}
+
+} // namespace detail
+} // namespace random
+} // namespace boost
+
+#endif // BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
+
+#endif // BOOST_RANDOM_DETAIL_AES_BLOCKS_HPP
@@ -63,7 +63,8 @@ struct aes_common : public prf_common<128/std::numeric_limits<Uint>::digits, 128
         : common_type(first, last), useAESNI(hasAESNI())
     { }
 
-    aes_common(aes_common& v) : common_type(static_cast<common_type &>(v)){}
+    aes_common(aes_common& v) : common_type(static_cast<common_type &>(v)), useAESNI(v.useAESNI)
+    {}
     aes_common(const aes_common& v) : common_type(static_cast<const common_type &>(v)), useAESNI(hasAESNI())
     {}
 
@@ -77,7 +78,7 @@ struct aes_common : public prf_common<128/std::numeric_limits<Uint>::digits, 128
 
     bool usehw(bool newval){
         if( newval && !hasAESNI() )
-            throw std::invalid_argument("AESNI is not compiled into this binary.  aes(true) is not allowed");
+            throw std::invalid_argument("AESNI is not compiled into this binary, or the processor lacks it.  usehw(true) is not allowed");
         bool oldval = useAESNI;
         useAESNI = newval;
         return oldval;
@@ -117,7 +118,7 @@ struct aes_common<__m128i> : public prf_common<1, 1, 1, __m128i>{
 
     bool usehw(bool newval){
         if( newval && !hasAESNI() )
-            throw std::invalid_argument("AESNI is not compiled into this binary.  aes(true) is not allowed");
+            throw std::invalid_argument("AESNI is not compiled into this binary, or the processor lacks it.  usehw(true) is not allowed");
         bool oldval = useAESNI;
         useAESNI = newval;
         return oldval;
@@ -44,4 +44,36 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 #endif
 
+// BOOST_HAS_AESNI_DISPATCH is defined if the AES-NI code can be
+// compiled without -maes, to be chosen at run time by hasAESNI():  by
+// gcc (4.9 and later) and clang through target attributes on the
+// functions that use it, and by MSVC, which always allows it.  Then a
+// single binary uses AES-NI where the processor has it, and the
+// software AES elsewhere.  Only x86_64 is supported.  Define it to 0 to
+// disable the run-time check.
+#ifndef BOOST_HAS_AESNI_DISPATCH
+#if (defined(__x86_64__) && (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) \
+    || defined(_M_X64)
+#define BOOST_HAS_AESNI_DISPATCH 1
+#endif
+#endif
+
+// BOOST_HAS_VAES_DISPATCH is defined if, in addition, the VAES
+// instructions, which do AES rounds on the four 128-bit lanes of an
+// AVX-512 register, can be compiled for a processor found at run time.
+#ifndef BOOST_HAS_VAES_DISPATCH
+#if BOOST_HAS_AESNI_DISPATCH && !defined(_MSC_VER) && (defined(__clang__) ? __clang_major__ >= 6 : __GNUC__ >= 8)
+#define BOOST_HAS_VAES_DISPATCH 1
+#endif
+#endif
+
+// The attributes of the functions using AES-NI and VAES.
+#if defined(__GNUC__) || defined(__clang__)
+#define BOOST_RANDOM_DETAIL_AESNI_TARGET __attribute__((target("aes,sse4.1")))
+#define BOOST_RANDOM_DETAIL_VAES_TARGET __attribute__((target("aes,vaes,avx512f")))
+#else
+#define BOOST_RANDOM_DETAIL_AESNI_TARGET
+#define BOOST_RANDOM_DETAIL_VAES_TARGET
+#endif
+
 #endif // BOOST_RANDOM_DETAIL_AES_CONFIG_HPP
@@ -32,9 +32,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BOOST_RANDOM_DETAIL_HASAESNI_HPP
 #define BOOST_RANDOM_DETAIL_HASAESNI_HPP
 
-#ifdef BOOST_HAS_AESNI
+#include "aes_config.hpp"
+
+#if BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
 #if defined(_MSC_FULL_VER)
-#include <intrin.h>  // for __cpuid
+#include <intrin.h>  // for __cpuid, __cpuidex and _xgetbv
 #endif
 #endif
 
@@ -42,7 +44,7 @@ namespace boost{
 namespace random{
 namespace detail{
 
-#ifdef BOOST_HAS_AESNI
+#if BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
 // Note that if  BOOST_HAS_AESNI is defined, we can safely assume that
 // we're on an x86_64 platform which significantly reduces the
 // breadth of the #ifdefs here.
@@ -53,27 +55,76 @@ namespace detail{
 // FIXME - this fails with -fPIC -m32.  It can be fixed by pushing
 // ebx, or by guaranteeing that BOOST_HAS_AESNI is never true when
 // compiling 32-bit.
-inline bool hasAESNI(){
-    unsigned int eax, ebx, ecx, edx;
-    __asm__ __volatile__ ("cpuid": "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) :
-                      "a" (1));
-    return (ecx>>25) & 1;
+inline void aes_cpuid(unsigned int leaf, unsigned int regs[4]){
+    __asm__ __volatile__ ("cpuid": "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3]) :
+                      "a" (leaf), "c" (0));
+}
+// The state components enabled by the OS.  Only call it if cpuid says
+// OSXSAVE.
+inline unsigned int aes_xgetbv(){
+    unsigned int eax, edx;
+    __asm__ __volatile__ ("xgetbv": "=a" (eax), "=d" (edx) : "c" (0));
+    return eax;
 }
 #elif defined(_MSC_FULL_VER)
-inline bool hasAESNI(){
+inline void aes_cpuid(unsigned int leaf, unsigned int regs[4]){
     int CPUInfo[4];
-    __cpuid(CPUInfo, 1);
-    return (CPUInfo[2]>>25)&1;
+    __cpuidex(CPUInfo, leaf, 0);
+    for(int i=0; i<4; ++i)
+        regs[i] = CPUInfo[i];
+}
+inline unsigned int aes_xgetbv(){
+    return static_cast<unsigned int>(_xgetbv(0));
 }
 #else
 #error "Don't know how to implement hasAESNI on this platform"
 #endif // __GNUC__ or _MSC_FULL_VER
 
-#else // BOOST_HAS_AESNI
+inline bool hasAESNI_uncached(){
+    unsigned int regs[4];
+    aes_cpuid(1, regs);
+    return (regs[2]>>25) & 1;
+}
+
+// Whether the processor has AES-NI.  It is checked once.
 inline bool hasAESNI(){
+    static const bool has = hasAESNI_uncached();
+    return has;
+}
+
+// Whether the processor has VAES and AVX-512F, and the OS saves the
+// AVX-512 registers.
+inline bool hasVAES_uncached(){
+    unsigned int regs[4];
+    aes_cpuid(0, regs);
+    if( regs[0] < 7 )
+        return false;
+    aes_cpuid(1, regs);
+    // OSXSAVE and AES
+    if( ((regs[2]>>27) & 1) == 0 || ((regs[2]>>25) & 1) == 0 )
+        return false;
+    // SSE, AVX, opmask and the upper ZMM registers
+    if( (aes_xgetbv() & 0xe6) != 0xe6 )
+        return false;
+    aes_cpuid(7, regs);
+    // AVX512F in ebx, VAES in ecx
+    return ((regs[1]>>16) & 1) && ((regs[2]>>9) & 1);
+}
+
+inline bool hasVAES(){
+    static const bool has = hasVAES_uncached();
+    return has;
+}
+
+#else // BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
+inline bool hasAESNI(){
+    return false;
+}
+
+inline bool hasVAES(){
     return false;
 }
-#endif // BOOST_HAS_AESNI
+#endif // BOOST_HAS_AESNI || BOOST_HAS_AESNI_DISPATCH
 
 } // namespace detail
 } // namespace random
@@ -0,0 +1,235 @@
+/** @page LICENSE
+Copyright 2026, agent <agent@local>.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+* Redistributions of source code must retain the above copyright
+  notice, this list of conditions, and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions, and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BOOST_RANDOM_DETAIL_PRF_LANES_HPP
+#define BOOST_RANDOM_DETAIL_PRF_LANES_HPP
+
+// Evaluation of a 32-bit PRF on a contiguous range of counters, several
+// counters at a time, one per lane of an SSE2, AVX2 or AVX-512 register.
+// Word j of the counters of a group is held in vector j, so that a round
+// of Philox or Threefry is the scalar round applied lane by lane, and the
+// results are bit-identical to the scalar ones.
+
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/random/detail/aes_config.hpp>
+#include <boost/random/detail/prf_range.hpp>
+#include <cstddef>
+
+#ifndef BOOST_HAS_AVX2
+#ifdef __AVX2__
+#define BOOST_HAS_AVX2 1
+#endif
+#endif
+
+#ifndef BOOST_HAS_AVX512F
+#ifdef __AVX512F__
+#define BOOST_HAS_AVX512F 1
+#endif
+#endif
+
+#if BOOST_HAS_AVX2 || BOOST_HAS_AVX512F
+#include <immintrin.h>
+#elif BOOST_HAS_M128i
+#include <emmintrin.h>
+#endif
+
+namespace boost{
+namespace random{
+namespace detail{
+
+// The lane operations on 32-bit words.  mulhilo returns the low
+// halves of the 64-bit products, and the high halves in hi.
+#if BOOST_HAS_AVX512F
+struct prf_lanes_avx512{
+    typedef __m512i vec;
+    static const unsigned lanes = 16;
+    static vec load(const uint32_t* p){ return _mm512_loadu_si512(p); }
+    static void store(uint32_t* p, vec x){ _mm512_storeu_si512(p, x); }
+    static vec set1(uint32_t a){ return _mm512_set1_epi32(static_cast<int>(a)); }
+    static vec add(vec a, vec b){ return _mm512_add_epi32(a, b); }
+    static vec bxor(vec a, vec b){ return _mm512_xor_si512(a, b); }
+    static vec rotl(vec x, unsigned s){ return _mm512_rolv_epi32(x, set1(s)); }
+    static vec mulhilo(vec a, vec b, vec& hi){
+        const vec even = _mm512_mul_epu32(a, b);
+        const vec odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+        hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+        return _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+    }
+};
+#endif
+
+#if BOOST_HAS_AVX2
+struct prf_lanes_avx2{
+    typedef __m256i vec;
+    static const unsigned lanes = 8;
+    static vec load(const uint32_t* p){ return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(uint32_t* p, vec x){ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+    static vec set1(uint32_t a){ return _mm256_set1_epi32(static_cast<int>(a)); }
+    static vec add(vec a, vec b){ return _mm256_add_epi32(a, b); }
+    static vec bxor(vec a, vec b){ return _mm256_xor_si256(a, b); }
+    static vec rotl(vec x, unsigned s){
+        return _mm256_or_si256(_mm256_sll_epi32(x, _mm_cvtsi32_si128(s)),
+                               _mm256_srl_epi32(x, _mm_cvtsi32_si128(32-s)));
+    }
+    static vec mulhilo(vec a, vec b, vec& hi){
+        const vec even = _mm256_mul_epu32(a, b);
+        const vec odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+        return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    }
+};
+#endif
+
+#if BOOST_HAS_M128i
+struct prf_lanes_sse2{
+    typedef __m128i vec;
+    static const unsigned lanes = 4;
+    static vec load(const uint32_t* p){ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(uint32_t* p, vec x){ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    static vec set1(uint32_t a){ return _mm_set1_epi32(static_cast<int>(a)); }
+    static vec add(vec a, vec b){ return _mm_add_epi32(a, b); }
+    static vec bxor(vec a, vec b){ return _mm_xor_si128(a, b); }
+    static vec rotl(vec x, unsigned s){
+        return _mm_or_si128(_mm_sll_epi32(x, _mm_cvtsi32_si128(s)),
+                            _mm_srl_epi32(x, _mm_cvtsi32_si128(32-s)));
+    }
+    static vec mulhilo(vec a, vec b, vec& hi){
+        const vec even = _mm_mul_epu32(a, b);
+        const vec odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        const vec low = _mm_srli_epi64(_mm_set1_epi32(-1), 32);
+        hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(low, odd));
+        return _mm_or_si128(_mm_and_si128(even, low), _mm_slli_epi64(odd, 32));
+    }
+};
+#endif
+
+// Two vectors of Lanes side by side, so that a kernel works on two
+// independent groups of counters:  the rounds are a chain of dependent
+// multiplications or additions, whose latency is then half hidden.
+template <typename Lanes>
+struct prf_lanes_x2{
+    struct vec{ typename Lanes::vec a, b; };
+    static const unsigned lanes = 2*Lanes::lanes;
+    static vec make(typename Lanes::vec a, typename Lanes::vec b){ vec x; x.a = a; x.b = b; return x; }
+    static vec load(const uint32_t* p){ return make(Lanes::load(p), Lanes::load(p+Lanes::lanes)); }
+    static void store(uint32_t* p, vec x){ Lanes::store(p, x.a); Lanes::store(p+Lanes::lanes, x.b); }
+    static vec set1(uint32_t a){ typename Lanes::vec x = Lanes::set1(a); return make(x, x); }
+    static vec add(vec a, vec b){ return make(Lanes::add(a.a, b.a), Lanes::add(a.b, b.b)); }
+    static vec bxor(vec a, vec b){ return make(Lanes::bxor(a.a, b.a), Lanes::bxor(a.b, b.b)); }
+    static vec rotl(vec x, unsigned s){ return make(Lanes::rotl(x.a, s), Lanes::rotl(x.b, s)); }
+    static vec mulhilo(vec a, vec b, vec& hi){
+        return make(Lanes::mulhilo(a.a, b.a, hi.a), Lanes::mulhilo(a.b, b.b, hi.b));
+    }
+};
+
+// The widest lane operations available for words of type Uint, or void
+// if there are none, in which case the PRFs evaluate counters one by one.
+template <typename Uint>
+struct prf_lanes_type{
+    typedef void type;
+};
+
+template <>
+struct prf_lanes_type<uint32_t>{
+#if BOOST_HAS_AVX512F
+    typedef prf_lanes_x2<prf_lanes_avx512> type;
+#elif BOOST_HAS_AVX2
+    typedef prf_lanes_x2<prf_lanes_avx2> type;
+#elif BOOST_HAS_M128i
+    typedef prf_lanes_x2<prf_lanes_sse2> type;
+#else
+    typedef void type;
+#endif
+};
+
+// Set out[i] = prf(c+i) for the first groups of Lanes::lanes counters in
+// [0, n), counting in the given word as prf_incr does, where
+// Kernel::apply<Lanes>(v, key) applies the PRF to the counters held word
+// by word in v[0], ..., v[N-1].  Advances c past the counters done and
+// returns their number;  the caller does the rest.
+template <typename Lanes, typename Kernel>
+struct prf_lanes{
+    template <typename Uint, std::size_t N, std::size_t Nkey>
+    static std::size_t apply(array<Uint, N>& c, const array<Uint, Nkey>& key,
+                             array<Uint, N>* out, std::size_t n, std::size_t word){
+        typedef typename Lanes::vec vec;
+        static const unsigned L = Lanes::lanes;
+        static const uint32_t iota[32] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                          16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31};
+
+        std::size_t i = 0;
+        for(; i+L <= n; i += L){
+            Uint w[N][L];
+            vec v[N];
+            if(c[word] <= ~Uint(0) - (L-1)){
+                // no carry out of the word within the group
+                for(std::size_t j=0; j<N; ++j)
+                    v[j] = Lanes::set1(c[j]);
+                v[word] = Lanes::add(v[word], Lanes::load(iota));
+                c[word] += L-1;
+                prf_incr(c, word);
+            }else{
+                for(unsigned l=0; l<L; ++l){
+                    for(std::size_t j=0; j<N; ++j)
+                        w[j][l] = c[j];
+                    prf_incr(c, word);
+                }
+                for(std::size_t j=0; j<N; ++j)
+                    v[j] = Lanes::load(w[j]);
+            }
+
+            Kernel::template apply<Lanes>(v, key);
+
+            for(std::size_t j=0; j<N; ++j)
+                Lanes::store(w[j], v[j]);
+            for(unsigned l=0; l<L; ++l)
+                for(std::size_t j=0; j<N; ++j)
+                    out[i+l][j] = w[j][l];
+        }
+        return i;
+    }
+};
+
+template <typename Kernel>
+struct prf_lanes<void, Kernel>{
+    template <typename Uint, std::size_t N, std::size_t Nkey>
+    static std::size_t apply(array<Uint, N>&, const array<Uint, Nkey>&,
+                             array<Uint, N>*, std::size_t, std::size_t){
+        return 0;
+    }
+};
+
+} // namespace detail
+} // namespace random
+} // namespace boost
+
+#endif // BOOST_RANDOM_DETAIL_PRF_LANES_HPP
@@ -0,0 +1,143 @@
+/** @page LICENSE
+Copyright 2026, agent <agent@local>.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+* Redistributions of source code must retain the above copyright
+  notice, this list of conditions, and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions, and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BOOST_RANDOM_DETAIL_PRF_RANGE_HPP
+#define BOOST_RANDOM_DETAIL_PRF_RANGE_HPP
+
+// Evaluation of a PRF on a range of consecutive counters, and the
+// helpers shared by the bulk generate() of the counter based engines.
+
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/limits.hpp>
+#include <cstddef>
+
+namespace boost{
+namespace random{
+namespace detail{
+
+// Increment a counter by one in the given word, carrying into the
+// words above it.  Word 0 is the least significant, and the counter
+// wraps around after the last one.
+template <typename Uint, std::size_t N>
+inline void prf_incr(array<Uint, N>& c, std::size_t word = 0){
+    for(std::size_t j=word; j<N; ++j)
+        if(++c[j] != 0)
+            return;
+}
+
+// Set out[i] to the i-th counter from c, counting in the given word,
+// for i < n.  Without a carry out of the word, which is the usual case,
+// only that word changes.
+template <typename Uint, std::size_t N>
+inline void prf_fill(array<Uint, N> c, array<Uint, N>* out, std::size_t n, std::size_t word = 0){
+    if(n != 0 && c[word] <= (std::numeric_limits<Uint>::max)() - (n-1)){
+        const Uint c0 = c[word];
+        for(std::size_t i=0; i<n; ++i){
+            out[i] = c;
+            out[i][word] = c0 + static_cast<Uint>(i);
+        }
+        return;
+    }
+    for(std::size_t i=0; i<n; ++i){
+        out[i] = c;
+        prf_incr(c, word);
+    }
+}
+
+// Whether Prf has a member
+//     void operator()(domain_type c, range_type* out, size_t n, size_t word)
+// setting out[i] to the value at the i-th counter from c, counting with
+// prf_incr(c, word).  The PRFs that do (philox, threefry, ars, aes)
+// specialize this.
+template <typename Prf>
+struct has_prf_range{
+    static const bool value = false;
+};
+
+template <typename Prf, bool = has_prf_range<Prf>::value>
+struct prf_range_impl{
+    static void apply(Prf& b, typename Prf::domain_type c, typename Prf::range_type* out,
+                      std::size_t n, std::size_t word){
+        for(std::size_t i=0; i<n; ++i){
+            out[i] = b(c);
+            prf_incr(c, word);
+        }
+    }
+};
+
+template <typename Prf>
+struct prf_range_impl<Prf, true>{
+    static void apply(Prf& b, typename Prf::domain_type c, typename Prf::range_type* out,
+                      std::size_t n, std::size_t word){
+        b(c, out, n, word);
+    }
+};
+
+// out[i] = b(c+i) for i < n, counting in the given word;  several at a
+// time if the PRF can.
+template <typename Prf>
+inline void prf_range(Prf& b, const typename Prf::domain_type& c, typename Prf::range_type* out,
+                      std::size_t n, std::size_t word = 0){
+    prf_range_impl<Prf>::apply(b, c, out, n, word);
+}
+
+// generate(first, last) of an engine with result_type Uint fills the
+// range with 32-bit words, as detail::generate_from_int does:  each
+// output gives prf_words<Uint>::words of them, low bits first.  When
+// Uint is not a whole number of 32-bit words, the engines fall back on
+// generate_from_int.
+template <typename Uint>
+struct prf_words{
+    static const bool whole = std::numeric_limits<Uint>::digits%32 == 0;
+    static const int words = std::numeric_limits<Uint>::digits/32;
+
+    // Write the words of x to first, ..., stopping at last.
+    // Returns false if last was reached.
+    template <class Iter>
+    static bool put(Uint x, Iter& first, Iter last){
+        for(int j=0; j<words; ++j){
+            *first = static_cast<boost::uint_least32_t>(x & 0xFFFFFFFFu);
+            if(++first == last)
+                return false;
+            // in two steps, in case Uint has exactly 32 bits
+            x >>= 16;
+            x >>= 16;
+        }
+        return true;
+    }
+};
+
+} // namespace detail
+} // namespace random
+} // namespace boost
+
+#endif // BOOST_RANDOM_DETAIL_PRF_RANGE_HPP
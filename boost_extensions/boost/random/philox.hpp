@@ -37,6 +37,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/limits.hpp>
 #include <boost/random/detail/mulhilo.hpp>
 #include <boost/random/detail/prf_common.hpp>
+#include <boost/random/detail/prf_lanes.hpp>
+#include <boost/random/detail/prf_range.hpp>
+#include <cstddef>
 
 namespace boost{
 namespace random{
@@ -75,6 +78,50 @@ struct philox_constants<4, uint32_t>{
     static const uint32_t W1 = UINT64_C(0xBB67AE85);  /* sqrt(3)-1 */
 };
 
+namespace detail{
+// The Philox rounds on counters held word by word in the lanes of v,
+// for detail::prf_lanes.
+template <unsigned R, typename Constants>
+struct philox2_kernel{
+    template <typename Lanes, typename Key>
+    static void apply(typename Lanes::vec* v, const Key& key){
+        typedef typename Lanes::vec vec;
+        const vec M0 = Lanes::set1(Constants::M0);
+        typename Key::value_type k0 = key[0];
+        for(unsigned r=0; r<R; ++r){
+            vec hi;
+            vec lo = Lanes::mulhilo(M0, v[0], hi);
+            v[0] = Lanes::bxor(Lanes::bxor(hi, Lanes::set1(k0)), v[1]);
+            v[1] = lo;
+            k0 += Constants::W0;
+        }
+    }
+};
+
+template <unsigned R, typename Constants>
+struct philox4_kernel{
+    template <typename Lanes, typename Key>
+    static void apply(typename Lanes::vec* v, const Key& key){
+        typedef typename Lanes::vec vec;
+        const vec M0 = Lanes::set1(Constants::M0);
+        const vec M1 = Lanes::set1(Constants::M1);
+        typename Key::value_type k0 = key[0];
+        typename Key::value_type k1 = key[1];
+        for(unsigned r=0; r<R; ++r){
+            vec hi0, hi1;
+            vec lo0 = Lanes::mulhilo(M0, v[0], hi0);
+            vec lo1 = Lanes::mulhilo(M1, v[2], hi1);
+            v[0] = Lanes::bxor(Lanes::bxor(hi1, v[1]), Lanes::set1(k0));
+            v[1] = lo1;
+            v[2] = Lanes::bxor(Lanes::bxor(hi0, v[3]), Lanes::set1(k1));
+            v[3] = lo0;
+            k0 += Constants::W0;
+            k1 += Constants::W1;
+        }
+    }
+};
+} // namespace detail
+
 template <unsigned N, typename Uint, unsigned R=10, typename Constants = philox_constants<N, Uint> >
 struct philox{
     BOOST_STATIC_ASSERT( N%2 == 0 );
@@ -117,6 +164,20 @@ public:
             round(c, kcopy);
         return c;
     }
+
+    // Evaluate the n consecutive counters c, c+1, ..., c+n-1 into
+    // out[0], ..., out[n-1], several at a time in SIMD lanes for 32-bit
+    // words.  The counters count in the given word, carrying into the
+    // words above it, as detail::prf_incr does;  word 0 is the least
+    // significant.
+    void operator()(_ctr_type c, _ctr_type* out, std::size_t n, std::size_t word = 0){
+        std::size_t i = detail::prf_lanes<typename detail::prf_lanes_type<Uint>::type,
+                                          detail::philox2_kernel<R, Constants> >::apply(c, this->k, out, n, word);
+        for(; i<n; ++i){
+            out[i] = (*this)(c);
+            detail::prf_incr(c, word);
+        }
+    }
 };
 
 template<typename Uint, unsigned R, typename Constants>
@@ -156,7 +217,25 @@ public:
             round(c, kcopy);
         return c;
     }        
+
+    // As for philox<2, ...>:  out[i] = (*this)(c+i) for i < n,
+    // counting in the given word.
+    void operator()(_ctr_type c, _ctr_type* out, std::size_t n, std::size_t word = 0){
+        std::size_t i = detail::prf_lanes<typename detail::prf_lanes_type<Uint>::type,
+                                          detail::philox4_kernel<R, Constants> >::apply(c, this->k, out, n, word);
+        for(; i<n; ++i){
+            out[i] = (*this)(c);
+            detail::prf_incr(c, word);
+        }
+    }
+};
+
+namespace detail{
+template <unsigned N, typename Uint, unsigned R, typename Constants>
+struct has_prf_range<philox<N, Uint, R, Constants> >{
+    static const bool value = true;
 };
+} // namespace detail
 
 } // namespace random
 } // namespace boost
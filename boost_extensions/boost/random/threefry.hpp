@@ -38,6 +38,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/limits.hpp>
 #include <boost/random/detail/prf_common.hpp>
 #include <boost/random/detail/rotl.hpp>
+#include <boost/random/detail/prf_lanes.hpp>
+#include <boost/random/detail/prf_range.hpp>
+#include <cstddef>
 
 namespace boost{
 namespace random{
@@ -97,6 +100,63 @@ const unsigned
 threefry_constants<4, uint64_t>::Rotations1[]  = {
     16, 57, 40, 37, 33, 12, 22, 32};
 
+namespace detail{
+// The Threefry rounds and key injections on counters held word by word
+// in the lanes of v, for detail::prf_lanes.
+template <unsigned R, typename Constants>
+struct threefry2_kernel{
+    template <typename Lanes, typename Key>
+    static void apply(typename Lanes::vec* v, const Key& key){
+        typedef typename Key::value_type Uint;
+        Uint ks[3];
+        ks[2] = Constants::KS_PARITY;
+        ks[0] = key[0]; ks[2] ^= key[0]; v[0] = Lanes::add(v[0], Lanes::set1(key[0]));
+        ks[1] = key[1]; ks[2] ^= key[1]; v[1] = Lanes::add(v[1], Lanes::set1(key[1]));
+
+        for(unsigned r=0; r<R; ){
+            v[0] = Lanes::add(v[0], v[1]); v[1] = Lanes::bxor(Lanes::rotl(v[1], Constants::Rotations[r%8]), v[0]);
+            ++r;
+            if((r&3)==0){
+                unsigned r4 = r>>2;
+                v[0] = Lanes::add(v[0], Lanes::set1(ks[r4%3]));
+                v[1] = Lanes::add(v[1], Lanes::set1(ks[(r4+1)%3] + r4));
+            }
+        }
+    }
+};
+
+template <unsigned R, typename Constants>
+struct threefry4_kernel{
+    template <typename Lanes, typename Key>
+    static void apply(typename Lanes::vec* v, const Key& key){
+        typedef typename Key::value_type Uint;
+        Uint ks[5];
+        ks[4] = Constants::KS_PARITY;
+        for(unsigned j=0; j<4; ++j){
+            ks[j] = key[j]; ks[4] ^= key[j]; v[j] = Lanes::add(v[j], Lanes::set1(key[j]));
+        }
+
+        for(unsigned r=0; r<R; ){
+            if((r&1)==0){
+                v[0] = Lanes::add(v[0], v[1]); v[1] = Lanes::bxor(Lanes::rotl(v[1], Constants::Rotations0[r%8]), v[0]);
+                v[2] = Lanes::add(v[2], v[3]); v[3] = Lanes::bxor(Lanes::rotl(v[3], Constants::Rotations1[r%8]), v[2]);
+            }else{
+                v[0] = Lanes::add(v[0], v[3]); v[3] = Lanes::bxor(Lanes::rotl(v[3], Constants::Rotations0[r%8]), v[0]);
+                v[2] = Lanes::add(v[2], v[1]); v[1] = Lanes::bxor(Lanes::rotl(v[1], Constants::Rotations1[r%8]), v[2]);
+            }
+            ++r;
+            if((r&3)==0){
+                unsigned r4 = r>>2;
+                v[0] = Lanes::add(v[0], Lanes::set1(ks[(r4+0)%5]));
+                v[1] = Lanes::add(v[1], Lanes::set1(ks[(r4+1)%5]));
+                v[2] = Lanes::add(v[2], Lanes::set1(ks[(r4+2)%5]));
+                v[3] = Lanes::add(v[3], Lanes::set1(ks[(r4+3)%5] + r4));
+            }
+        }
+    }
+};
+} // namespace detail
+
 template <unsigned N, typename Uint, unsigned R=20, typename Constants=threefry_constants<N, Uint> >
 struct threefry{
     BOOST_STATIC_ASSERT( N==2 || N==4 );
@@ -150,6 +210,20 @@ public:
         }
         return c; 
     }
+
+    // Evaluate the n consecutive counters c, c+1, ..., c+n-1 into
+    // out[0], ..., out[n-1], several at a time in SIMD lanes for 32-bit
+    // words.  The counters count in the given word, carrying into the
+    // words above it, as detail::prf_incr does;  word 0 is the least
+    // significant.
+    void operator()(_ctr_type c, _ctr_type* out, std::size_t n, std::size_t word = 0){
+        std::size_t i = detail::prf_lanes<typename detail::prf_lanes_type<Uint>::type,
+                                          detail::threefry2_kernel<R, Constants> >::apply(c, this->k, out, n, word);
+        for(; i<n; ++i){
+            out[i] = (*this)(c);
+            detail::prf_incr(c, word);
+        }
+    }
 };
 
 template<typename Uint, unsigned R, typename Constants>
@@ -206,9 +280,27 @@ public:
         }
         return c; 
     }
+
+    // As for threefry<2, ...>:  out[i] = (*this)(c+i) for i < n,
+    // counting in the given word.
+    void operator()(_ctr_type c, _ctr_type* out, std::size_t n, std::size_t word = 0){
+        std::size_t i = detail::prf_lanes<typename detail::prf_lanes_type<Uint>::type,
+                                          detail::threefry4_kernel<R, Constants> >::apply(c, this->k, out, n, word);
+        for(; i<n; ++i){
+            out[i] = (*this)(c);
+            detail::prf_incr(c, word);
+        }
+    }
 };
 
 
+namespace detail{
+template <unsigned N, typename Uint, unsigned R, typename Constants>
+struct has_prf_range<threefry<N, Uint, R, Constants> >{
+    static const bool value = true;
+};
+} // namespace detail
+
 } // namespace random
 } // namespace boost
 
@@ -47,16 +47,22 @@ BOOST_CONCEPT_ASSERT((RandomNumberFunctor< boost::random::aes<uint64_t> >));
 // Numbers:  As Easy as 1, 2, 3")
 BOOST_AUTO_TEST_CASE(test_kat_aes4x32)
 {
-    dokat<aes<uint32_t> >("00000000 00000000 00000000 00000000 00000000 00000000 00000000 00000000   d44be966 3b2c8aef 59fa4c88 2e2b34ca");
-    dokat<aes<uint32_t> >("ffffffff ffffffff ffffffff ffffffff ffffffff ffffffff 00000000 00000000   0f68399f cc680a67 4cbd230d 816d2e23");
-    dokat<aes<uint32_t> >("243f6a88 85a308d3 13198a2e 03707344 a4093822 299f31d0 082efa98 ec4e6c89   ca693cbf 134a4f64 965e0cfd 5217a28f");
-    dokat<aes<uint32_t> >("33221100 77665544 bbaa9988 ffeeddcc 03020100 07060504 0b0a0908 0f0e0d0c   d8e0c469 30047b6a 80b7cdd8 5ac5b470");
+    dokat_sw<aes<uint32_t> >("00000000 00000000 00000000 00000000 00000000 00000000 00000000 00000000   d44be966 3b2c8aef 59fa4c88 2e2b34ca");
+    dokat_sw<aes<uint32_t> >("ffffffff ffffffff ffffffff ffffffff ffffffff ffffffff 00000000 00000000   0f68399f cc680a67 4cbd230d 816d2e23");
+    dokat_sw<aes<uint32_t> >("243f6a88 85a308d3 13198a2e 03707344 a4093822 299f31d0 082efa98 ec4e6c89   ca693cbf 134a4f64 965e0cfd 5217a28f");
+    dokat_sw<aes<uint32_t> >("33221100 77665544 bbaa9988 ffeeddcc 03020100 07060504 0b0a0908 0f0e0d0c   d8e0c469 30047b6a 80b7cdd8 5ac5b470");
 }
 
 BOOST_AUTO_TEST_CASE(test_kat_aes2x64)
 {
-    dokat<aes<uint64_t> >("0000000000000000 0000000000000000 0000000000000000 0000000000000000    3b2c8aefd44be966 2e2b34ca59fa4c88");
-    dokat<aes<uint64_t> >("ffffffffffffffff ffffffffffffffff ffffffffffffffff 0000000000000000   cc680a670f68399f  816d2e234cbd230d");
-    dokat<aes<uint64_t> >("85a308d3243f6a88  0370734413198a2e  299f31d0a4093822  ec4e6c89082efa98    134a4f64ca693cbf  5217a28f965e0cfd");
-    dokat<aes<uint64_t> >("7766554433221100 ffeeddccbbaa9988  0706050403020100  0f0e0d0c0b0a0908    30047b6ad8e0c469  5ac5b47080b7cdd8");
+    dokat_sw<aes<uint64_t> >("0000000000000000 0000000000000000 0000000000000000 0000000000000000    3b2c8aefd44be966 2e2b34ca59fa4c88");
+    dokat_sw<aes<uint64_t> >("ffffffffffffffff ffffffffffffffff ffffffffffffffff 0000000000000000   cc680a670f68399f  816d2e234cbd230d");
+    dokat_sw<aes<uint64_t> >("85a308d3243f6a88  0370734413198a2e  299f31d0a4093822  ec4e6c89082efa98    134a4f64ca693cbf  5217a28f965e0cfd");
+    dokat_sw<aes<uint64_t> >("7766554433221100 ffeeddccbbaa9988  0706050403020100  0f0e0d0c0b0a0908    30047b6ad8e0c469  5ac5b47080b7cdd8");
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_aes)
+{
+    dogenerate<aes<uint32_t> >();
+    dogenerate<aes<uint64_t> >();
 }
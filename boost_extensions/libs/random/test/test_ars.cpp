@@ -47,14 +47,20 @@ BOOST_CONCEPT_ASSERT((RandomNumberFunctor< boost::random::ars<uint64_t> >));
 // Numbers:  As Easy as 1, 2, 3")
 BOOST_AUTO_TEST_CASE(test_kat_ars4x32)
 {
-    dokat<ars<uint32_t, 10> >("00000000 00000000 00000000 00000000 00000000 00000000 00000000 00000000   8d73ee19 506401ef 13c2dbe4 0cbe9c0d");
-    dokat<ars<uint32_t, 10> >("243f6a88 85a308d3 13198a2e 03707344 a4093822 299f31d0 082efa98 ec4e6c89   a516e7d6 8357ad74 5b59b3ec 8763fff3");
-    dokat<ars<uint32_t, 10> >("ffffffff ffffffff ffffffff ffffffff ffffffff ffffffff 00000000 00000000   bb3743b1 9f635551 ecbc87fc a19478a9");
+    dokat_sw<ars<uint32_t, 10> >("00000000 00000000 00000000 00000000 00000000 00000000 00000000 00000000   8d73ee19 506401ef 13c2dbe4 0cbe9c0d");
+    dokat_sw<ars<uint32_t, 10> >("243f6a88 85a308d3 13198a2e 03707344 a4093822 299f31d0 082efa98 ec4e6c89   a516e7d6 8357ad74 5b59b3ec 8763fff3");
+    dokat_sw<ars<uint32_t, 10> >("ffffffff ffffffff ffffffff ffffffff ffffffff ffffffff 00000000 00000000   bb3743b1 9f635551 ecbc87fc a19478a9");
 }
 
 BOOST_AUTO_TEST_CASE(test_kat_ars2x64)
 {
-    dokat<ars<uint64_t, 10> >("0000000000000000 0000000000000000 0000000000000000 0000000000000000   506401ef8d73ee19 0cbe9c0d13c2dbe4");
-    dokat<ars<uint64_t, 10> >("85a308d3243f6a88  0370734413198a2e  299f31d0a4093822  ec4e6c89082efa98    8357ad74a516e7d6  8763fff35b59b3ec");
-    dokat<ars<uint64_t, 10> >("ffffffffffffffff ffffffffffffffff ffffffffffffffff 0000000000000000   9f635551bb3743b1  a19478a9ecbc87fc");
+    dokat_sw<ars<uint64_t, 10> >("0000000000000000 0000000000000000 0000000000000000 0000000000000000   506401ef8d73ee19 0cbe9c0d13c2dbe4");
+    dokat_sw<ars<uint64_t, 10> >("85a308d3243f6a88  0370734413198a2e  299f31d0a4093822  ec4e6c89082efa98    8357ad74a516e7d6  8763fff35b59b3ec");
+    dokat_sw<ars<uint64_t, 10> >("ffffffffffffffff ffffffffffffffff ffffffffffffffff 0000000000000000   9f635551bb3743b1  a19478a9ecbc87fc");
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_ars)
+{
+    dogenerate<ars<uint32_t> >();
+    dogenerate<ars<uint64_t> >();
 }
@@ -0,0 +1,118 @@
+/** @page LICENSE
+Copyright 2026, agent <agent@local>.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+* Redistributions of source code must retain the above copyright
+  notice, this list of conditions, and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions, and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <boost/random/counter_based_random_access.hpp>
+#include <boost/random/philox.hpp>
+#include <boost/random/threefry.hpp>
+#include <boost/cstdint.hpp>
+#include <stdexcept>
+#include <vector>
+
+using boost::random::counter_based_random_access;
+using boost::random::philox;
+using boost::random::threefry;
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+// The documented counter layout, for 32-bit and 64-bit words.
+BOOST_AUTO_TEST_CASE(test_counter_layout)
+{
+    typedef counter_based_random_access<philox<4, uint32_t> > ra32;
+    ra32::domain_type c = ra32::counter(UINT64_C(0x0123456789abcdef), 0x2468ace0, 0x13579bdf);
+    BOOST_CHECK_EQUAL(c[0], 0x13579bdfu);
+    BOOST_CHECK_EQUAL(c[1], 0x2468ace0u);
+    BOOST_CHECK_EQUAL(c[2], 0x89abcdefu);
+    BOOST_CHECK_EQUAL(c[3], 0x01234567u);
+    BOOST_CHECK_EQUAL(ra32::stream_key(UINT64_C(0x0123456789abcdef))[0], 0x89abcdefu);
+    BOOST_CHECK_EQUAL(ra32::stream_key(UINT64_C(0x0123456789abcdef))[1], 0x01234567u);
+
+    typedef counter_based_random_access<threefry<2, uint64_t> > ra64;
+    ra64::domain_type d = ra64::counter(UINT64_C(0x0123456789abcdef), 0x2468ace0, 0x13579bdf);
+    BOOST_CHECK_EQUAL(d[0], UINT64_C(0x2468ace013579bdf));
+    BOOST_CHECK_EQUAL(d[1], UINT64_C(0x0123456789abcdef));
+    BOOST_CHECK_EQUAL(ra64::stream_key(7)[0], 7u);
+    BOOST_CHECK_EQUAL(ra64::stream_key(7)[1], 0u);
+}
+
+template <typename Prf>
+void doaccess(){
+    typedef counter_based_random_access<Prf> ra_t;
+    const ra_t ra(42);
+    Prf prf(ra_t::stream_key(42));
+    const boost::uint64_t path = UINT64_C(1) << 40, step = 17;
+    const std::size_t K = ra_t::values_per_block;
+
+    // single values are the PRF at the documented counter
+    for(boost::uint64_t dim=0; dim<3*K; ++dim){
+        typename Prf::range_type r = prf(ra_t::counter(path, step, dim / K));
+        BOOST_CHECK_EQUAL(ra(path, step, dim), r[dim % K]);
+        double u = ra.uniform(path, step, dim);
+        BOOST_CHECK(u > 0 && u < 1);
+        BOOST_CHECK_EQUAL(u, ra_t::to_uniform(r[dim % K]));
+    }
+
+    // runs of dimensions, starting and ending part way through blocks
+    static const std::size_t n = 1001;
+    std::vector<typename ra_t::result_type> values(n);
+    std::vector<double> uniforms(n);
+    for(boost::uint64_t first=0; first<=K+1; ++first){
+        ra(path, step, first, &values[0], n);
+        ra.uniforms(path, step, first, &uniforms[0], n);
+        for(std::size_t i=0; i<n; ++i){
+            BOOST_CHECK_EQUAL(values[i], ra(path, step, first + i));
+            BOOST_CHECK_EQUAL(uniforms[i], ra.uniform(path, step, first + i));
+        }
+    }
+
+    // the coordinates and the stream all matter
+    BOOST_CHECK_NE(ra(path, step, 0), ra(path + 1, step, 0));
+    BOOST_CHECK_NE(ra(path, step, 0), ra(path, step + 1, 0));
+    BOOST_CHECK_NE(ra(path, step, 0), ra(path, step, K));
+    BOOST_CHECK_NE(ra(path, step, 0), ra_t(43)(path, step, 0));
+
+    // the largest coordinates, and one beyond
+    const boost::uint64_t max_dim = (UINT64_C(1) << 32) * K - 1;
+    ra(~UINT64_C(0), 0xffffffff, max_dim);
+    BOOST_CHECK_THROW(ra(path, UINT64_C(1) << 32, 0), std::out_of_range);
+    BOOST_CHECK_THROW(ra(path, step, max_dim + 1), std::out_of_range);
+    BOOST_CHECK_THROW(ra.uniforms(path, step, max_dim - 1, &uniforms[0], 3), std::out_of_range);
+    ra.uniforms(path, step, max_dim - 1, &uniforms[0], 2);
+    BOOST_CHECK_EQUAL(uniforms[1], ra.uniform(path, step, max_dim));
+}
+
+BOOST_AUTO_TEST_CASE(test_random_access)
+{
+    doaccess<philox<4, uint32_t> >();
+    doaccess<philox<2, uint64_t> >();
+    doaccess<threefry<4, uint32_t> >();
+    doaccess<threefry<2, uint64_t> >();
+}
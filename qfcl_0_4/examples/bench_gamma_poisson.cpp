@@ -0,0 +1,111 @@
+/* examples/bench_gamma_poisson.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+// Timings of the gamma, Poisson and chi-squared distributions, against those of boost, 
+// in the manner of bench_normal.cpp.
+
+#include "qfcl/random/distribution/chi_squared.hpp"
+#include "qfcl/random/distribution/gamma.hpp"
+#include "qfcl/random/distribution/poisson.hpp"
+#include "qfcl/random/engine/mersenne_twister.hpp"
+
+#include <boost/random/chi_squared_distribution.hpp>
+#include <boost/random/gamma_distribution.hpp>
+#include <boost/random/non_central_chi_squared_distribution.hpp>
+#include <boost/random/poisson_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const long N = 10*1000*1000;
+
+// time N variates of rng, one at a time
+template<class RNG>
+void time_variates(const std::string & name, RNG & rng)
+{
+    double sum = 0;
+    boost::posix_time::ptime time_start(boost::posix_time::microsec_clock::local_time() );
+    for (long i=0; i<N; ++i)
+        sum += rng();
+    boost::posix_time::ptime time_end(boost::posix_time::microsec_clock::local_time() );
+    boost::posix_time::time_duration duration( time_end - time_start );
+    double dt = 0.001* duration.total_milliseconds();
+    std::cout << name << ": " << dt << " sec" << " (mean " << sum / N << ")" << std::endl;
+}
+
+// the distribution d of qfcl against its boost counterpart bd
+template<class Distribution, class BoostDistribution>
+void compare(const std::string & name, const Distribution & d, const BoostDistribution & bd)
+{
+    typedef qfcl::random::mt19937 ENG;
+
+    {
+        ENG eng;
+        boost::variate_generator< ENG &, BoostDistribution > rng(eng, bd);
+        time_variates("boost " + name, rng);
+    }
+    {
+        ENG eng;
+        qfcl::random::variate_generator< ENG &, Distribution > rng(eng, d);
+        time_variates("qfcl " + name, rng);
+    }
+}
+
+}   // anonymous namespace
+
+int main()
+{
+    compare( "gamma(0.5)", qfcl::random::gamma_distribution<>(0.5), boost::random::gamma_distribution<>(0.5) );
+    compare( "gamma(2.5)", qfcl::random::gamma_distribution<>(2.5), boost::random::gamma_distribution<>(2.5) );
+    compare( "gamma(30)", qfcl::random::gamma_distribution<>(30), boost::random::gamma_distribution<>(30) );
+
+    compare( "poisson(0.5)", qfcl::random::poisson_distribution<>(0.5), boost::random::poisson_distribution<>(0.5) );
+    compare( "poisson(5)", qfcl::random::poisson_distribution<>(5), boost::random::poisson_distribution<>(5) );
+    compare( "poisson(50)", qfcl::random::poisson_distribution<>(50), boost::random::poisson_distribution<>(50) );
+    compare( "poisson(5000)", qfcl::random::poisson_distribution<>(5000), boost::random::poisson_distribution<>(5000) );
+
+    compare( "chi_squared(3)", qfcl::random::chi_squared_distribution<>(3), boost::random::chi_squared_distribution<>(3) );
+    compare( "noncentral_chi_squared(0.5, 2)", qfcl::random::noncentral_chi_squared_distribution<>(0.5, 2),
+             boost::random::non_central_chi_squared_distribution<>(0.5, 2) );
+    compare( "noncentral_chi_squared(3, 2)", qfcl::random::noncentral_chi_squared_distribution<>(3, 2),
+             boost::random::non_central_chi_squared_distribution<>(3, 2) );
+
+    {
+        // as for the variance of a CIR process, whose noncentrality differs from path to path
+        typedef qfcl::random::mt19937 ENG;
+        typedef qfcl::random::noncentral_chi_squared_distribution<> DIST;
+
+        ENG eng;
+        qfcl::random::variate_generator< ENG &, DIST > rng(eng, DIST(0.8, 0));
+
+        const long block_size = 4096;
+        std::vector<double> lambda(block_size), block(block_size);
+        for (long j=0; j<block_size; ++j)
+            lambda[j] = 0.5 + j % 7;
+
+        double sum = 0;
+        boost::posix_time::ptime time_start(boost::posix_time::microsec_clock::local_time() );
+        for (long i=0; i<N; i+=block_size) {
+            rng.generate(&lambda[0], &block[0], block_size);
+            for (long j=0; j<block_size; ++j)
+                sum += block[j];
+        }
+        boost::posix_time::ptime time_end(boost::posix_time::microsec_clock::local_time() );
+        boost::posix_time::time_duration duration( time_end - time_start );
+        double dt = 0.001* duration.total_milliseconds();
+        std::cout << "qfcl noncentral_chi_squared(0.8, lambda[i]) (batch): " << dt << " sec" << std::endl;
+    }
+
+    return 0;
+}
@@ -3,17 +3,21 @@
 //  Use, modification and distribution are subject to the BOOST Software License. 
 // (See accompanying file LICENSE.txt)
 
+#include "qfcl/random/buffered_variate_generator.hpp"
 #include "qfcl/random/engine/cpp_rand.hpp"
 #include "qfcl/random/distribution/normal_box_muller_polar.hpp"
 #include "qfcl/random/distribution/normal_box_muller.hpp"
 #include "qfcl/random/distribution/normal_inversion.hpp"
+#include "qfcl/random/distribution/normal_ziggurat.hpp"
 #include "qfcl/random/distribution/uniform_0in_1in.hpp"
+#include "qfcl/random/distribution/uniform_0ex_1ex.hpp"
 
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
 #include <iostream>
+#include <vector>
 
 int main()
 {
@@ -97,6 +101,26 @@ int main()
 
     }
 
+    {
+        typedef qfcl::random::cpp_rand ENG;
+        typedef qfcl::random::normal_ziggurat<> DIST;
+    
+        ENG eng;
+        DIST dist;
+    
+        qfcl::random::variate_generator< ENG, DIST > rng(eng, dist);
+
+        double sum = 0;
+        boost::posix_time::ptime time_start(boost::posix_time::microsec_clock::local_time() );
+        for (long i=0; i<N; ++i)
+            sum += rng();
+        boost::posix_time::ptime time_end(boost::posix_time::microsec_clock::local_time() );
+        boost::posix_time::time_duration duration( time_end - time_start );
+        double dt = 0.001* duration.total_milliseconds();
+        std::cout << "qfcl::normal_ziggurat: " << dt << " sec" << std::endl;
+
+    }
+
     {
         typedef qfcl::random::cpp_rand ENG;
         typedef qfcl::random::normal_inversion DIST;
@@ -116,6 +140,55 @@ int main()
         std::cout << "qfcl::normal_inversion: " << dt << " sec" << std::endl;
 
     }
+
+    {
+        typedef qfcl::random::cpp_rand ENG;
+        typedef qfcl::random::uniform_0ex_1ex<> DIST;
+    
+        ENG eng;
+        DIST dist;
+    
+        qfcl::random::variate_generator< ENG, DIST > rng(eng, dist);
+
+        // uniforms are drawn a block at a time and inverted in place
+        const long block_size = 4096;
+        std::vector<double> block(block_size);
+
+        double sum = 0;
+        boost::posix_time::ptime time_start(boost::posix_time::microsec_clock::local_time() );
+        for (long i=0; i<N; i+=block_size) {
+            for (long j=0; j<block_size; ++j)
+                block[j] = rng();
+            qfcl::random::detail::normal_inv(&block[0], &block[0], block_size);
+            for (long j=0; j<block_size; ++j)
+                sum += block[j];
+        }
+        boost::posix_time::ptime time_end(boost::posix_time::microsec_clock::local_time() );
+        boost::posix_time::time_duration duration( time_end - time_start );
+        double dt = 0.001* duration.total_milliseconds();
+        std::cout << "qfcl::normal_inversion (batch): " << dt << " sec" << std::endl;
+
+    }
+
+    {
+        typedef qfcl::random::cpp_rand ENG;
+        typedef qfcl::random::normal_inversion DIST;
+    
+        ENG eng;
+        DIST dist;
+    
+        qfcl::random::buffered_variate_generator< ENG, DIST > rng(eng, dist);
+
+        double sum = 0;
+        boost::posix_time::ptime time_start(boost::posix_time::microsec_clock::local_time() );
+        for (long i=0; i<N; ++i)
+            sum += rng();
+        boost::posix_time::ptime time_end(boost::posix_time::microsec_clock::local_time() );
+        boost::posix_time::time_duration duration( time_end - time_start );
+        double dt = 0.001* duration.total_milliseconds();
+        std::cout << "qfcl::normal_inversion (buffered): " << dt << " sec" << std::endl;
+
+    }
     
     return 0;
 }
\ No newline at end of file
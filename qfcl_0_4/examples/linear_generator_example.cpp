@@ -142,9 +142,10 @@ int main(int argc, char * argv[])
 	computed_jump_matrix = computed_jump_matrix || !exists;
 
 	// make num_jump jumps
+	// (by default discard uses the minimal polynomial, which needs no jump matrix)
 	for (size_t i = 0; i < num_steps; ++i)
 	{
-		eng.discard(step_size - 1);
+		eng.discard(step_size - 1, qfcl::random::matrix_jump);
 		cout << "Random number " 
 			 << qfcl::io::custom_formatted( (i + 1) * step_size )
 			 << " from reference state:" << endl;
@@ -179,7 +180,7 @@ int main(int argc, char * argv[])
 
 		// reverse the engine reverse_jump_size + 1 states
 		// (1 step back returns us to num_jumps * jump_size.)
-		eng.reverse_discard(reverse_jump_size + 1);
+		eng.reverse_discard(reverse_jump_size + 1, qfcl::random::matrix_jump);
 		// output next number
 		cout << eng() << endl << endl;
 #else
@@ -58,3 +58,24 @@ BoostNormal<Generator>::~BoostNormal()
     std::cerr << "Debug: " << myRandom << std::endl;
 	delete myRandom;
 }
+
+template <typename Generator>
+BufferedNormal<Generator>::BufferedNormal(const Generator& generator, long N) : 
+					myRandom(Generator(static_cast<boost::uint32_t> (std::time(0))), qfcl::random::std_normal_inversion_distribution<>()), 
+					vec(ublas::vector<double>(N, 0.0))
+{
+}
+
+template <typename Generator>
+void BufferedNormal<Generator>::getNormalVector()
+{ 
+
+	myRandom.generate(vec.begin(), vec.size());
+	
+}
+
+template <typename Generator>
+double BufferedNormal<Generator>::RN() const
+{
+	return myRandom();
+}
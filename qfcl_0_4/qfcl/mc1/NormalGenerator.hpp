@@ -18,6 +18,9 @@
 
 #include <boost/random.hpp>
 
+#include <qfcl/random/buffered_variate_generator.hpp>
+#include <qfcl/random/distribution/normal_inversion.hpp>
+
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/io.hpp>			// Sending to IO stream.
 
@@ -44,6 +47,26 @@ public:
 	~BoostNormal();
 };
 
+// The same interface, with the N(0,1) numbers generated and inverted a block at a time
+// by the inverse normal cdf. The variates differ from those of BoostNormal.
+template <typename Generator>
+				class BufferedNormal
+{
+private:
+	typedef qfcl::random::buffered_variate_generator<Generator, qfcl::random::std_normal_inversion_distribution<> > generator_type;
+
+	mutable generator_type myRandom;
+
+public: // for convenience
+
+	ublas::vector<double> vec;
+
+public:
+	BufferedNormal(const Generator& generator, long N);	// Generate N N(0,1) numbers
+	void getNormalVector();
+	double RN() const;
+};
+
 
 
 #endif
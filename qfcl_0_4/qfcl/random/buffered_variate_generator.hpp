@@ -0,0 +1,194 @@
+/* qfcl/random/buffered_variate_generator.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_BUFFERED_VARIATE_GENERATOR_HPP
+#define QFCL_RANDOM_BUFFERED_VARIATE_GENERATOR_HPP
+
+/*! \file qfcl/random/buffered_variate_generator.hpp
+	\brief A variate generator that produces its variates a block at a time
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/aligned_storage.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+#include <qfcl/random/variate_generator.hpp>
+#include <qfcl/random/distribution/random_bits.hpp>
+#include <qfcl/utility/type_traits.hpp>
+
+namespace qfcl {
+namespace random {
+
+namespace detail {
+
+//! the next \p n outputs of \p e, using the bulk \c generate of the engine
+template<class Engine, typename UIntType>
+inline void engine_fill(Engine & e, UIntType * dest, std::size_t n, boost::mpl::true_)
+{
+	e.generate(dest, n);
+}
+
+//! the next \p n outputs of \p e, for engines without a bulk \c generate
+template<class Engine, typename UIntType>
+inline void engine_fill(Engine & e, UIntType * dest, std::size_t n, boost::mpl::false_)
+{
+	for (std::size_t i = 0; i < n; ++i)
+		dest[i] = e();
+}
+
+//! a cache line aligned array of \p N elements of \p T
+template<typename T, std::size_t N>
+class aligned_block
+{
+public:
+	T * data() {return static_cast<T *>( static_cast<void *>(&_storage) );}
+	const T * data() const {return static_cast<const T *>( static_cast<const void *>(&_storage) );}
+private:
+	typename boost::aligned_storage<N * sizeof(T), 64>::type _storage;
+};
+
+/*! \brief Fills a block with variates of \p Distribution
+
+	When \p Distribution specializes \c block_transform, a block of engine outputs is generated
+	and then transformed in one pass. Otherwise the variates are drawn one at a time from the
+	\c variate_generator, in a loop that the compiler can inline.
+*/
+template<class Engine, class Distribution, std::size_t BlockSize,
+		 bool Transform = block_transform<Distribution>::supported>
+class variate_block_filler
+{
+public:
+	typedef typename variate_generator<Engine, Distribution>::result_type result_type;
+
+	variate_block_filler(const Engine & e, const Distribution & d) : _rng(e, d) {}
+
+	void operator()(result_type * dest)
+	{
+		for (std::size_t i = 0; i < BlockSize; ++i)
+			dest[i] = _rng();
+	}
+private:
+	variate_generator<Engine, Distribution> _rng;
+};
+
+template<class Engine, class Distribution, std::size_t BlockSize>
+class variate_block_filler<Engine, Distribution, BlockSize, true>
+{
+	typedef typename boost::remove_reference<Engine>::type engine_value_type;
+	typedef typename engine_value_type::result_type engine_result_type;
+	static const std::size_t outputs = block_transform_outputs<Distribution, engine_result_type>::value;
+public:
+	typedef typename Distribution::result_type result_type;
+
+	variate_block_filler(const Engine & e, const Distribution & d) : _eng(e), _dist(d)
+	{
+		const std::size_t k = block_transform_outputs<Distribution, engine_result_type>::for_bits( engine_bits(_eng) );
+		if (k > outputs)
+			_narrow_raw.resize(k * BlockSize);
+	}
+
+	void operator()(result_type * dest)
+	{
+		// an engine with too few bits per output for _raw
+		engine_result_type * raw = _narrow_raw.empty() ? _raw.data() : &_narrow_raw[0];
+		const std::size_t n = _narrow_raw.empty() ? outputs * BlockSize : _narrow_raw.size();
+
+		engine_fill( _eng, raw, n, traits::has_generate<engine_value_type>() );
+		block_transform<Distribution>::apply( _dist, raw, dest, BlockSize,
+			static_cast<engine_result_type>( (_eng.min)() ), static_cast<engine_result_type>( (_eng.max)() ) );
+	}
+private:
+	Engine _eng;
+	Distribution _dist;
+	aligned_block<engine_result_type, outputs * BlockSize> _raw;
+	std::vector<engine_result_type> _narrow_raw;
+};
+
+}	// namespace detail
+
+/*! \brief A \c variate_generator that produces \p BlockSize variates at a time, and serves them from a buffer
+
+	This removes the overhead of a call to the engine (and of the transformation) per variate:
+	a whole block of engine outputs is generated, with the bulk \c generate of the engine when it
+	has one, and transformed in a single pass, using the batch transformation of the distribution
+	when it has one (see \c block_transform), e.g. the SIMD inverse normal cdf. For the uniform
+	distributions the output is identical to that of \c variate_generator.
+
+	The engine is held by value, like \c variate_generator, unless \p Engine is a reference type.
+
+	\tparam BlockSize the number of variates generated at a time; the buffers take about
+	\c BlockSize * 16 bytes, which should fit comfortably in the L1 or L2 cache
+*/
+template<class Engine, class Distribution, std::size_t BlockSize = 1024>
+class buffered_variate_generator
+{
+	typedef detail::variate_block_filler<Engine, Distribution, BlockSize> filler_type;
+public:
+	typedef Engine engine_type;
+	typedef Distribution distribution_type;
+	typedef typename filler_type::result_type result_type;
+
+	//! the number of variates generated at a time
+	static const std::size_t block_size = BlockSize;
+
+	buffered_variate_generator(const engine_type & e, const distribution_type & d)
+		: _filler(e, d), _next(BlockSize)
+	{
+	}
+
+	//! the next variate
+	result_type operator()()
+	{
+		if (_next == BlockSize)
+			refill();
+
+		return _buffer.data()[_next++];
+	}
+
+	//! write the next \p num variates to \p dest, and return the end of the output
+	template<typename OutIt>
+	OutIt generate(OutIt dest, std::size_t num)
+	{
+		while (num > 0)
+		{
+			if (_next == BlockSize)
+				refill();
+
+			const std::size_t m = num < BlockSize - _next ? num : BlockSize - _next;
+			for (std::size_t i = 0; i < m; ++i, ++dest)
+				*dest = _buffer.data()[_next + i];
+
+			_next += m;
+			num -= m;
+		}
+
+		return dest;
+	}
+private:
+	void refill()
+	{
+		_filler( _buffer.data() );
+		_next = 0;
+	}
+
+	filler_type _filler;
+	detail::aligned_block<result_type, BlockSize> _buffer;
+	//! index of the next variate in the buffer
+	std::size_t _next;
+};
+
+}}	// namespaces
+
+#endif	// QFCL_RANDOM_BUFFERED_VARIATE_GENERATOR_HPP
@@ -0,0 +1,201 @@
+/* qfcl/random/distribution/chi_squared.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_DISTRIBUTION_CHI_SQUARED_HPP
+#define QFCL_RANDOM_DISTRIBUTION_CHI_SQUARED_HPP
+
+/*! \file qfcl/random/distribution/chi_squared.hpp
+	\brief The central and noncentral chi-squared distributions
+
+	A chi-squared variate with \f$k\f$ degrees of freedom is twice a gamma variate with shape \f$k/2\f$.
+	A noncentral one, with noncentrality \f$\lambda\f$, is \f$(z + \sqrt{\lambda})^2 + \chi^2_{k-1}\f$
+	for a standard normal \f$z\f$ when \f$k \ge 1\f$, and otherwise the Poisson mixture
+	\f$\chi^2_{k + 2N}\f$, \f$N\f$ Poisson with mean \f$\lambda/2\f$. This is the transition distribution
+	of the CIR process (and of the variance in the Heston model), for which \f$\lambda\f$ differs from
+	path to path: see the \c generate taking an array of noncentralities.
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <qfcl/random/distribution/gamma.hpp>
+#include <qfcl/random/distribution/normal_ziggurat.hpp>
+#include <qfcl/random/distribution/poisson.hpp>
+#include <qfcl/random/variate_generator.hpp>
+#include <cmath>
+#include <cstddef>
+
+namespace qfcl {
+namespace random {
+
+//! the chi-squared distribution with \c k degrees of freedom, which need not be an integer
+template<class RealType = double>
+struct chi_squared_distribution
+{
+    typedef RealType result_type;
+
+    explicit chi_squared_distribution(RealType k_ = 1) : k(k_) {}
+
+    RealType k;
+};
+
+//! the noncentral chi-squared distribution with \c k degrees of freedom and noncentrality \c lambda
+template<class RealType = double>
+struct noncentral_chi_squared_distribution
+{
+    typedef RealType result_type;
+
+    noncentral_chi_squared_distribution(RealType k_ = 1, RealType lambda_ = 0) : k(k_), lambda(lambda_) {}
+
+    RealType k;
+    RealType lambda;
+};
+
+namespace detail {
+
+//! draws noncentral chi-squared variates from an engine
+template<typename RealType>
+class noncentral_chi_squared_sampler
+{
+public:
+    noncentral_chi_squared_sampler(RealType k, RealType lambda)
+    : _k(k), _sqrt_lambda( std::sqrt(lambda) ), _chi_squared( k > 1 ? (k - 1) / 2 : 1 ), _poisson( k < 1 ? lambda / 2 : 0 )
+    {
+    }
+
+    //! the engine \p e has \p bits_per_call random bits per output
+    template<class Engine>
+    RealType operator()(Engine & e, unsigned bits_per_call) const
+    {
+        if (_k < 1)
+            return mixture(e, bits_per_call, _poisson);
+
+        return normal_part(e, bits_per_call, _sqrt_lambda);
+    }
+
+    //! a variate with the noncentrality \p lambda instead
+    template<class Engine>
+    RealType operator()(Engine & e, unsigned bits_per_call, RealType lambda) const
+    {
+        if (_k < 1)
+            return mixture( e, bits_per_call, poisson_sampler<long, RealType>(lambda / 2, false) );
+
+        return normal_part( e, bits_per_call, std::sqrt(lambda) );
+    }
+private:
+    template<class Engine>
+    RealType normal_part(Engine & e, unsigned bits_per_call, RealType sqrt_lambda) const
+    {
+        const RealType x = _normal(e, bits_per_call) + sqrt_lambda;
+        return _k > 1 ? x * x + 2 * _chi_squared(e, bits_per_call) : x * x;
+    }
+
+    template<class Engine>
+    RealType mixture(Engine & e, unsigned bits_per_call, const poisson_sampler<long, RealType> & poisson) const
+    {
+        const long N = poisson(e, bits_per_call);
+        return 2 * gamma_sampler<RealType>(_k / 2 + N)(e, bits_per_call);
+    }
+
+    RealType _k;
+    RealType _sqrt_lambda;
+    //! half of a chi-squared variate with k - 1 degrees of freedom, for k > 1
+    gamma_sampler<RealType> _chi_squared;
+    //! the number of extra degrees of freedom, halved, for k < 1
+    poisson_sampler<long, RealType> _poisson;
+    normal_ziggurat_sampler<RealType> _normal;
+};
+
+} // namespace detail
+
+template<class Engine, class RealType>
+class variate_generator<Engine, chi_squared_distribution<RealType> >
+{
+public:
+    typedef Engine                                  engine_type;
+    typedef chi_squared_distribution<RealType>      distribution_type;
+    typedef RealType                                result_type;
+
+public:
+    // constructor
+    variate_generator(const engine_type & e, const distribution_type & d)
+    : _eng(e), _dist(d), _bits_per_call( detail::engine_bits(_eng) ), _sampler(d.k / 2)
+    {
+    }
+
+    result_type operator()()
+    {
+        return 2 * _sampler(_eng, _bits_per_call);
+    }
+
+    //! write the next \p n variates to \p dest, and return the end of the output
+    template<typename OutIt>
+    OutIt generate(OutIt dest, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i, ++dest)
+            *dest = 2 * _sampler(_eng, _bits_per_call);
+
+        return dest;
+    }
+
+private:
+    engine_type         _eng;
+    distribution_type   _dist;
+
+    unsigned            _bits_per_call;
+    detail::gamma_sampler<RealType> _sampler;
+};
+
+template<class Engine, class RealType>
+class variate_generator<Engine, noncentral_chi_squared_distribution<RealType> >
+{
+public:
+    typedef Engine                                          engine_type;
+    typedef noncentral_chi_squared_distribution<RealType>   distribution_type;
+    typedef RealType                                        result_type;
+
+public:
+    // constructor
+    variate_generator(const engine_type & e, const distribution_type & d)
+    : _eng(e), _dist(d), _bits_per_call( detail::engine_bits(_eng) ), _sampler(d.k, d.lambda)
+    {
+    }
+
+    result_type operator()()
+    {
+        return _sampler(_eng, _bits_per_call);
+    }
+
+    //! write the next \p n variates to \p dest, and return the end of the output
+    template<typename OutIt>
+    OutIt generate(OutIt dest, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i, ++dest)
+            *dest = _sampler(_eng, _bits_per_call);
+
+        return dest;
+    }
+
+    //! a variate for each of the \p n noncentralities \p lambda[i], written to \p dest[i]
+    void generate(const RealType * lambda, RealType * dest, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            dest[i] = _sampler(_eng, _bits_per_call, lambda[i]);
+    }
+
+private:
+    engine_type         _eng;
+    distribution_type   _dist;
+
+    unsigned            _bits_per_call;
+    detail::noncentral_chi_squared_sampler<RealType> _sampler;
+};
+
+}} // namespaces
+#endif
@@ -0,0 +1,361 @@
+/* qfcl/random/distribution/correlated_gbm_at_fixed_time.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_DISTRIBUTION_CORRELATED_GBM_AT_FIXED_TIME_HPP
+#define QFCL_RANDOM_DISTRIBUTION_CORRELATED_GBM_AT_FIXED_TIME_HPP
+
+/*! \file qfcl/random/distribution/correlated_gbm_at_fixed_time.hpp
+	\brief The values at a fixed time of several correlated geometric Brownian motions
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <qfcl/random/buffered_variate_generator.hpp>
+#include <qfcl/random/distribution/normal_inversion.hpp>
+#include <qfcl/utility/simd.hpp>
+
+namespace qfcl {
+namespace random {
+
+namespace detail {
+
+/*! \brief The Cholesky factor \f$L\f$ of the symmetric positive semidefinite \p d by \p d matrix \p a, in place
+
+	\p a is row major, and on return holds \f$L\f$ in its lower triangle and zeros above the diagonal.
+	A pivot that is zero up to rounding gives a zero column, so singular matrices (e.g. with perfectly
+	correlated assets) are factorized. Returns \c false if \f$L L^T\f$ does not reproduce \p a, i.e.
+	if \p a is not positive semidefinite, or has entries that are not finite.
+*/
+inline bool cholesky(std::vector<double> & a, std::size_t d)
+{
+	static const double tolerance = 1e-12;
+
+	const std::vector<double> original(a);
+
+	for (std::size_t j = 0; j < d; ++j)
+	{
+		double pivot = a[j * d + j];
+		for (std::size_t k = 0; k < j; ++k)
+			pivot -= a[j * d + k] * a[j * d + k];
+
+		if (pivot < -tolerance)
+			return false;
+		const double l = pivot > tolerance ? std::sqrt(pivot) : 0;
+
+		a[j * d + j] = l;
+		for (std::size_t i = j + 1; i < d; ++i)
+		{
+			double x = a[i * d + j];
+			for (std::size_t k = 0; k < j; ++k)
+				x -= a[i * d + k] * a[j * d + k];
+			a[i * d + j] = l > 0 ? x / l : 0;
+			a[j * d + i] = 0;
+		}
+	}
+
+	for (std::size_t i = 0; i < d; ++i)
+		for (std::size_t j = 0; j <= i; ++j)
+		{
+			double x = 0;
+			for (std::size_t k = 0; k <= j; ++k)
+				x += a[i * d + k] * a[j * d + k];
+			// also false for NaN
+			if ( !(std::fabs( x - original[i * d + j] ) <= 1e-10) )
+				return false;
+		}
+
+	return true;
+}
+
+/*! \brief Replaces the symmetric \p d by \p d matrix \p a, with unit diagonal, by a nearby correlation matrix
+
+	The spectral method of Rebonato and J&auml;ckel: the eigenvalues of \p a, found by cyclic Jacobi
+	rotations, are clipped at 0, and the resulting positive semidefinite matrix is rescaled to have
+	unit diagonal.
+*/
+inline void repair_correlation(std::vector<double> & a, std::size_t d)
+{
+	// a is diagonalized in place, and q accumulates the rotations
+	std::vector<double> q(d * d, 0.0);
+	for (std::size_t i = 0; i < d; ++i)
+		q[i * d + i] = 1;
+
+	for (int sweep = 0; sweep < 100; ++sweep)
+	{
+		double off = 0;
+		for (std::size_t i = 0; i < d; ++i)
+			for (std::size_t j = i + 1; j < d; ++j)
+				off += a[i * d + j] * a[i * d + j];
+		if (off < 1e-30)
+			break;
+
+		for (std::size_t p = 0; p < d; ++p)
+			for (std::size_t r = p + 1; r < d; ++r)
+			{
+				const double apr = a[p * d + r];
+				if (apr == 0)
+					continue;
+
+				// the rotation by (c, s) in the (p, r) plane annihilates a[p][r]
+				const double theta = (a[r * d + r] - a[p * d + p]) / (2 * apr);
+				const double t = (theta >= 0 ? 1 : -1) / ( std::fabs(theta) + std::sqrt(theta * theta + 1) );
+				const double c = 1 / std::sqrt(t * t + 1), s = t * c;
+
+				for (std::size_t k = 0; k < d; ++k)
+				{
+					const double akp = a[k * d + p], akr = a[k * d + r];
+					a[k * d + p] = c * akp - s * akr;
+					a[k * d + r] = s * akp + c * akr;
+				}
+				for (std::size_t k = 0; k < d; ++k)
+				{
+					const double apk = a[p * d + k], ark = a[r * d + k];
+					a[p * d + k] = c * apk - s * ark;
+					a[r * d + k] = s * apk + c * ark;
+				}
+				for (std::size_t k = 0; k < d; ++k)
+				{
+					const double qkp = q[k * d + p], qkr = q[k * d + r];
+					q[k * d + p] = c * qkp - s * qkr;
+					q[k * d + r] = s * qkp + c * qkr;
+				}
+			}
+	}
+
+	std::vector<double> lambda(d);
+	for (std::size_t k = 0; k < d; ++k)
+		lambda[k] = std::max( a[k * d + k], 0.0 );
+
+	for (std::size_t i = 0; i < d; ++i)
+		for (std::size_t j = 0; j < d; ++j)
+		{
+			double x = 0;
+			for (std::size_t k = 0; k < d; ++k)
+				x += q[i * d + k] * lambda[k] * q[j * d + k];
+			a[i * d + j] = x;
+		}
+
+	std::vector<double> scale(d);
+	for (std::size_t i = 0; i < d; ++i)
+		scale[i] = a[i * d + i] > 0 ? 1 / std::sqrt( a[i * d + i] ) : 0;
+	for (std::size_t i = 0; i < d; ++i)
+		for (std::size_t j = 0; j < d; ++j)
+			a[i * d + j] = i == j ? 1 : a[i * d + j] * scale[i] * scale[j];
+}
+
+//! the number of rows of the factor processed together, which share the loads of the normals
+const std::size_t correlated_gbm_rows = 4;
+
+/*! \brief The terminal values <tt>out[i * out_stride + k]</tt> \f$= F_i \exp( (L z_k)_i )\f$, two SIMD vectors of paths at a time
+
+	\c L has \p d columns and its rows are padded with zero rows to a multiple of \c correlated_gbm_rows,
+	\c F is padded likewise, and the normals of path \c k are <tt>z[j * z_stride + k]</tt>. The rows
+	of the product are computed \c correlated_gbm_rows at a time, for two vectors of paths, in registers:
+	each vector of normals loaded is used for all of the rows, and each entry of \c L for both vectors.
+	Returns the number of paths done, a multiple of \c 2 * Ops::lanes.
+*/
+template<typename Ops>
+struct correlated_gbm_lanes
+{
+	template<typename RealType>
+	static std::size_t apply(const RealType * L, const RealType * F, std::size_t d,
+		const RealType * z, std::size_t z_stride, RealType * out, std::size_t out_stride, std::size_t n)
+	{
+		typedef typename Ops::vector vector;
+
+		std::size_t k = 0;
+		for (; k + 2 * Ops::lanes <= n; k += 2 * Ops::lanes)
+			for (std::size_t i = 0; i < d; i += correlated_gbm_rows)
+			{
+				const RealType * row = L + i * d;
+				vector acc0 = Ops::set1( RealType(0) ), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+				vector acc4 = acc0, acc5 = acc0, acc6 = acc0, acc7 = acc0;
+
+				// L is lower triangular
+				const std::size_t end = std::min(i + correlated_gbm_rows, d);
+				for (std::size_t j = 0; j < end; ++j)
+				{
+					const vector z0 = Ops::load(z + j * z_stride + k), z1 = Ops::load(z + j * z_stride + k + Ops::lanes);
+					const vector l0 = Ops::set1( row[j] ), l1 = Ops::set1( row[d + j] );
+					const vector l2 = Ops::set1( row[2 * d + j] ), l3 = Ops::set1( row[3 * d + j] );
+					acc0 = Ops::add( acc0, Ops::mul(l0, z0) );
+					acc1 = Ops::add( acc1, Ops::mul(l1, z0) );
+					acc2 = Ops::add( acc2, Ops::mul(l2, z0) );
+					acc3 = Ops::add( acc3, Ops::mul(l3, z0) );
+					acc4 = Ops::add( acc4, Ops::mul(l0, z1) );
+					acc5 = Ops::add( acc5, Ops::mul(l1, z1) );
+					acc6 = Ops::add( acc6, Ops::mul(l2, z1) );
+					acc7 = Ops::add( acc7, Ops::mul(l3, z1) );
+				}
+
+				const vector acc[] = {acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7};
+				for (std::size_t r = 0; r < correlated_gbm_rows && i + r < d; ++r)
+				{
+					const vector F_r = Ops::set1( F[i + r] );
+					RealType * dest = out + (i + r) * out_stride + k;
+					Ops::store( dest, Ops::mul( F_r, simd::exp<Ops>( acc[r] ) ) );
+					Ops::store( dest + Ops::lanes, Ops::mul( F_r, simd::exp<Ops>( acc[r + correlated_gbm_rows] ) ) );
+				}
+			}
+
+		return k;
+	}
+};
+
+template<>
+struct correlated_gbm_lanes<void>
+{
+	template<typename RealType>
+	static std::size_t apply(const RealType *, const RealType *, std::size_t, const RealType *, std::size_t,
+		RealType *, std::size_t, std::size_t)
+	{
+		return 0;
+	}
+};
+
+}	// namespace detail
+
+/*! \brief The values at time \f$t\f$ of \f$d\f$ correlated geometric Brownian motions
+
+	Asset \f$i\f$ has initial value \f$S_i\f$, volatility \f$\sigma_i\f$ and growth rate \f$\mu_i\f$ (the
+	\c yield), and the Brownian motions have correlation matrix \f$\rho\f$. Its value at time \f$t\f$ is
+	\f$S_i \exp( (\mu_i - \sigma_i^2/2) t + \sigma_i \sqrt{t} (L z)_i )\f$, where \f$z\f$ is a vector of
+	independent standard normals and \f$L\f$ is the Cholesky factor of \f$\rho\f$, \f$L L^T = \rho\f$.
+
+	The factor is computed once, on construction, and \f$\sigma_i \sqrt{t}\f$ is folded into it. If
+	\f$\rho\f$ is not positive semidefinite, e.g. because it was estimated from incomplete data, it is
+	first replaced by a nearby correlation matrix (see \c repaired).
+
+	The values are produced in batch, for \c n paths at a time, in structure of arrays layout:
+	the value of asset \c i on path \c k is <tt>out[i * n + k]</tt>.
+*/
+template<typename RealType = double, typename NormalDistribution = normal_inversion_distribution<RealType> >
+class correlated_gbm_at_fixed_time_distribution
+{
+public:
+	typedef RealType input_type;
+	typedef RealType result_type;
+
+	/*! \param S0, vol, yield the initial values, volatilities and growth rates of the \c d assets
+		\param correlation the \c d by \c d correlation matrix, row major
+		\param t the time
+		\throw std::invalid_argument if the sizes do not agree, \p correlation is not symmetric with unit diagonal,
+		or it cannot be factorized even after being repaired, e.g. because it has entries that are not finite
+	*/
+	correlated_gbm_at_fixed_time_distribution(const std::vector<RealType> & S0, const std::vector<RealType> & vol,
+		const std::vector<RealType> & yield, const std::vector<RealType> & correlation, RealType t)
+		: _d( S0.size() ), _padded_d( (_d + detail::correlated_gbm_rows - 1) / detail::correlated_gbm_rows * detail::correlated_gbm_rows ),
+		  _factor(_padded_d * _d), _forward(_padded_d), _repaired(false)
+	{
+		if (vol.size() != _d || yield.size() != _d || correlation.size() != _d * _d)
+			throw std::invalid_argument("correlated_gbm_at_fixed_time_distribution: inconsistent number of assets");
+
+		std::vector<double> a( correlation.begin(), correlation.end() );
+		for (std::size_t i = 0; i < _d; ++i)
+		{
+			if (a[i * _d + i] != 1)
+				throw std::invalid_argument("correlated_gbm_at_fixed_time_distribution: correlation matrix must have unit diagonal");
+			for (std::size_t j = 0; j < i; ++j)
+				if (std::fabs( a[i * _d + j] - a[j * _d + i] ) > 1e-12)
+					throw std::invalid_argument("correlated_gbm_at_fixed_time_distribution: correlation matrix must be symmetric");
+		}
+
+		std::vector<double> L(a);
+		if ( !detail::cholesky(L, _d) )
+		{
+			detail::repair_correlation(a, _d);
+			L = a;
+			if ( !detail::cholesky(L, _d) )
+				throw std::invalid_argument("correlated_gbm_at_fixed_time_distribution: correlation matrix could not be repaired");
+			_repaired = true;
+		}
+
+		for (std::size_t i = 0; i < _d; ++i)
+		{
+			const double diffusion = vol[i] * std::sqrt( static_cast<double>(t) );
+			for (std::size_t j = 0; j <= i; ++j)
+				_factor[i * _d + j] = static_cast<RealType>( diffusion * L[i * _d + j] );
+
+			_forward[i] = static_cast<RealType>( S0[i] * std::exp( (yield[i] - 0.5 * vol[i] * vol[i]) * t ) );
+		}
+	}
+
+	//! the number of assets
+	std::size_t dimension() const {return _d;}
+
+	//! whether the correlation matrix was not positive semidefinite, and was replaced by a nearby one
+	bool repaired() const {return _repaired;}
+
+	/*! \brief The terminal values for the standard normals \p z
+
+		The normals for path \c k are <tt>z[j * n + k]</tt>, \c j < \c dimension(), and the value of
+		asset \c i is written to <tt>out[i * n + k]</tt>. \p out must not overlap \p z.
+	*/
+	void terminal_values(const RealType * z, RealType * out, std::size_t n) const
+	{
+		transform(z, n, out, n, n);
+	}
+
+	//! \p n paths of terminal values, written to <tt>out[i * n + k]</tt>, from normals drawn from \p eng in blocks
+	template<class Engine>
+	void sample(Engine & eng, RealType * out, std::size_t n) const
+	{
+		buffered_variate_generator<Engine &, NormalDistribution> normals( eng, NormalDistribution() );
+		std::vector<RealType> z(_d * block_size);
+
+		for (std::size_t k = 0; k < n; k += block_size)
+		{
+			const std::size_t m = n - k < block_size ? n - k : block_size;
+			for (std::size_t j = 0; j < _d; ++j)
+				normals.generate(&z[j * block_size], m);
+
+			transform(&z[0], block_size, out + k, n, m);
+		}
+	}
+private:
+	//! the number of paths done at a time by \c sample, whose normals stay in the L1 or L2 cache
+	static const std::size_t block_size = 256;
+
+	void transform(const RealType * z, std::size_t z_stride, RealType * out, std::size_t out_stride, std::size_t n) const
+	{
+		typedef typename simd::real_ops<RealType>::type Ops;
+
+		std::size_t k = detail::correlated_gbm_lanes<Ops>::apply( &_factor[0], &_forward[0], _d, z, z_stride, out, out_stride, n );
+		for (; k < n; ++k)
+			for (std::size_t i = 0; i < _d; ++i)
+			{
+				RealType x = 0;
+				for (std::size_t j = 0; j <= i; ++j)
+					x += _factor[i * _d + j] * z[j * z_stride + k];
+				out[i * out_stride + k] = _forward[i] * std::exp(x);
+			}
+	}
+
+	std::size_t _d;
+	//! the number of rows of \c _factor and \c _forward
+	std::size_t _padded_d;
+	//! the Cholesky factor scaled by the diffusions, row major with zero rows for padding
+	std::vector<RealType> _factor;
+	//! \f$S_i \exp( (\mu_i - \sigma_i^2/2) t )\f$
+	std::vector<RealType> _forward;
+	bool _repaired;
+};
+
+typedef correlated_gbm_at_fixed_time_distribution<double> correlated_gbm_at_fixed_time;
+
+}}	// namespaces
+
+#endif	// QFCL_RANDOM_DISTRIBUTION_CORRELATED_GBM_AT_FIXED_TIME_HPP
@@ -0,0 +1,115 @@
+/* qfcl/random/distribution/exponential_ziggurat.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_DISTRIBUTION_EXPONENTIAL_ZIGGURAT_HPP
+#define QFCL_RANDOM_DISTRIBUTION_EXPONENTIAL_ZIGGURAT_HPP
+
+/*! \file qfcl/random/distribution/exponential_ziggurat.hpp
+	\brief The standard exponential distribution by the ziggurat method
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <qfcl/random/distribution/ziggurat_table.hpp>
+#include <qfcl/random/variate_generator.hpp>
+#include <boost/type_traits/make_signed.hpp>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+
+namespace qfcl {
+namespace random {
+
+//! the exponential distribution with rate 1, by the ziggurat method
+template<class RealType = double>
+struct exponential_ziggurat { typedef RealType result_type; };
+
+namespace detail {
+
+//! draws standard exponential variates from an engine, see \c ziggurat_table
+template<typename RealType>
+class exponential_ziggurat_sampler
+{
+public:
+    typedef typename ziggurat_uint<RealType>::type UIntType;
+    typedef typename boost::make_signed<UIntType>::type IntType;
+    typedef ziggurat_table<ziggurat_exponential_density, UIntType, RealType> table_type;
+
+    exponential_ziggurat_sampler() : _table( &table_type::get() ) {}
+
+    //! the engine \p e has \p bits_per_call random bits per output
+    template<class Engine>
+    RealType operator()(Engine & e, unsigned bits_per_call) const
+    {
+        static const unsigned shift = sizeof(UIntType) * CHAR_BIT - table_type::significand_bits;
+
+        const table_type & t = *_table;
+        RealType offset = 0;
+
+        for (;;)
+        {
+            const UIntType b = random_bits<UIntType>(e, bits_per_call);
+            const std::size_t i = static_cast<std::size_t>( b & (table_type::layers - 1) );
+            const UIntType j = b >> shift;
+            // j fits in the signed type, which converts faster
+            const RealType x = static_cast<RealType>( static_cast<IntType>(j) ) * t.w[i];
+
+            if (j < t.k[i])
+                return offset + x;
+
+            if (i == 0)
+            {
+                // the tail is again exponential, shifted by r
+                offset += static_cast<RealType>( ziggurat_exponential_density::r() );
+                continue;
+            }
+
+            // the wedge between the layer's rectangle and the density
+            const RealType y = t.f[i] + random_unit<RealType, UIntType>(e, bits_per_call) * (t.f[i + 1] - t.f[i]);
+            if ( y < std::exp(-x) )
+                return offset + x;
+        }
+    }
+private:
+    const table_type * _table;
+};
+
+} // namespace detail
+
+template<class Engine, class RealType >
+class variate_generator<Engine, exponential_ziggurat<RealType> >
+{
+public:
+    typedef Engine                          engine_type;
+    typedef exponential_ziggurat<RealType>  distribution_type;
+    typedef RealType                        result_type;
+
+public:
+    // constructor
+    variate_generator(const engine_type & e, const distribution_type & d)
+    : _eng(e), _dist(d), _bits_per_call( detail::engine_bits(_eng) )
+    {
+    }
+    
+    result_type operator()() 
+    {
+        return _sampler(_eng, _bits_per_call);
+    }
+
+private:
+    engine_type         _eng;
+    distribution_type   _dist;
+
+    unsigned            _bits_per_call;
+    detail::exponential_ziggurat_sampler<RealType> _sampler;
+};
+
+}} // namespaces
+#endif
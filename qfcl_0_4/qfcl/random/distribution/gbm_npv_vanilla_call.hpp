@@ -6,14 +6,70 @@
 #ifndef QFCL_RANDOM_DISTRIBUTION_GBM_VANILLA_CALL
 #define QFCL_RANDOM_DISTRIBUTION_GBM_VANILLA_CALL
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <qfcl/random/variate_generator.hpp>
+#include <qfcl/random/buffered_variate_generator.hpp>
 #include <qfcl/random/distribution/normal_inversion.hpp>
+#include <qfcl/utility/simd.hpp>
 
 namespace qfcl {
 
 namespace random {
 
+namespace detail {
+
+// The discounted call payoffs max(F g - K, 0), g = exp(diffusion z), for the normals z, a SIMD vector
+// at a time. F is the discounted forward S0 exp(drift) and K the discounted strike. With Antithetic 
+// the payoff is the average of those for z and -z, which needs only the one exp since exp(-diffusion z) = 1/g.
+// Returns the number of payoffs written, a multiple of Ops::lanes.
+template<typename Ops, bool Antithetic>
+struct gbm_call_payoff_lanes
+{
+    template<typename RealType>
+    static std::size_t apply(const RealType* z, RealType* out, std::size_t n,
+        RealType forward, RealType diffusion, RealType npv_strike)
+    {
+        typedef typename Ops::vector vector;
+
+        const vector F = Ops::set1(forward);
+        const vector s = Ops::set1(diffusion);
+        const vector K = Ops::set1(npv_strike);
+        const vector zero = Ops::set1( RealType(0) );
+
+        std::size_t i = 0;
+        for (; i + Ops::lanes <= n; i += Ops::lanes)
+        {
+            const vector g = simd::exp<Ops>( Ops::mul( s, Ops::load(z + i) ) );
+
+            vector up = Ops::sub( Ops::mul(F, g), K );
+            up = Ops::select( Ops::less(zero, up), up, zero );
+            if (Antithetic)
+            {
+                vector down = Ops::sub( Ops::div(F, g), K );
+                down = Ops::select( Ops::less(zero, down), down, zero );
+                up = Ops::mul( Ops::add(up, down), Ops::set1( RealType(0.5) ) );
+            }
+            Ops::store(out + i, up);
+        }
+
+        return i;
+    }
+};
+
+template<bool Antithetic>
+struct gbm_call_payoff_lanes<void, Antithetic>
+{
+    template<typename RealType>
+    static std::size_t apply(const RealType*, RealType*, std::size_t, RealType, RealType, RealType)
+    {
+        return 0;
+    }
+};
+
+}	// namespace detail
+
 template< typename RealType = double, typename normal_distribution_type = normal_inversion_distribution<RealType> >
 class gbm_vanilla_call_distribution
 {
@@ -34,8 +90,38 @@ private:
     RealType m_drift;
     RealType m_diffusion;
     RealType m_npv_strike;
+    RealType m_npv_forward;
+
+    // number of normals drawn at a time by the bulk samplers
+    static const std::size_t block_size = 1024;
 
+    template<bool Antithetic>
+    void batch_payoffs(const RealType* z, RealType* out, std::size_t n) const
+    {
+        typedef typename simd::real_ops<RealType>::type Ops;
 
+        std::size_t i = detail::gbm_call_payoff_lanes<Ops, Antithetic>::apply(z, out, n, m_npv_forward, m_diffusion, m_npv_strike);
+        for (; i < n; ++i)
+        {
+            const RealType g = std::exp( m_diffusion*z[i] );
+            RealType payoff = std::max( m_npv_forward*g - m_npv_strike, RealType(0) );
+            if (Antithetic)
+                payoff = ( payoff + std::max( m_npv_forward/g - m_npv_strike, RealType(0) ) ) / 2;
+            out[i] = payoff;
+        }
+    }
+
+    template<bool Antithetic, class Engine>
+    void batch_sample(Engine& eng, RealType* out, std::size_t n) const
+    {
+        buffered_variate_generator<Engine&, normal_distribution_type, block_size> NGen( eng, normal_distribution_type() );
+        for (std::size_t i = 0; i < n; i += block_size)
+        {
+            const std::size_t m = n - i < block_size ? n - i : block_size;
+            NGen.generate(out + i, m);
+            batch_payoffs<Antithetic>(out + i, out + i, m);
+        }
+    }
 
 public:
     typedef RealType input_type;
@@ -60,13 +146,15 @@ public:
         m_drift = (m_yield - m_r - 0.5*m_vol*m_vol)*m_t;
         m_diffusion = std::sqrt(m_t)*m_vol;
         m_npv_strike = std::exp(-m_r*m_t)*m_strike;
+        m_npv_forward = m_S0*std::exp(m_drift);
     }
     
     // Generate random number
+    // (the generator refers to eng, so that eng is advanced and its state is not copied)
     template<class Engine>
     result_type operator()(Engine& eng) const
     {
-        variate_generator<Engine, normal_distribution_type> NGen( eng, normal_distribution_type() );        
+        variate_generator<Engine&, normal_distribution_type> NGen( eng, normal_distribution_type() );        
         //RealType N = ND(eng);
 		RealType N = NGen();
         
@@ -74,6 +162,37 @@ public:
         return std::max( St - m_npv_strike, 0.);
     }
 
+    // Batched sampling, for when many payoffs are needed at once. The drift is folded into the
+    // discounted forward, and the exponentials are taken a SIMD vector at a time, so the results
+    // may differ from operator() in the last bits.
+
+    // The discounted payoffs for the standard normals z[0], ..., z[n-1]; out may be z
+    void payoffs(const RealType* z, RealType* out, std::size_t n) const
+    {
+        batch_payoffs<false>(z, out, n);
+    }
+
+    // The antithetic payoffs: out[i] is the average of the payoffs for z[i] and -z[i]; out may be z
+    void antithetic_payoffs(const RealType* z, RealType* out, std::size_t n) const
+    {
+        batch_payoffs<true>(z, out, n);
+    }
+
+    // n discounted payoffs, from normals drawn from eng in blocks
+    // (eng is advanced by whole blocks, so some of its outputs may go unused)
+    template<class Engine>
+    void sample(Engine& eng, RealType* out, std::size_t n) const
+    {
+        batch_sample<false>(eng, out, n);
+    }
+
+    // n antithetic payoffs, each from one normal drawn from eng and its negative
+    template<class Engine>
+    void antithetic_sample(Engine& eng, RealType* out, std::size_t n) const
+    {
+        batch_sample<true>(eng, out, n);
+    }
+
 };
 
 typedef gbm_vanilla_call_distribution<double> gbm_vanilla_call;
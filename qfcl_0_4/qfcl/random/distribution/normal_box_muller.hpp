@@ -27,8 +27,8 @@ public:
 
 public:
     // constructor
-    variate_generator(engine_type e, distribution_type d)
-    : _eng(e), _dist(d), _valid(false), _uniform_rng(e,_uniform_distribution)
+    variate_generator(const engine_type & e, const distribution_type & d)
+    : _dist(d), _uniform_rng(e, uniform_distribution_type()), _valid(false)
     {
     }
     
@@ -52,10 +52,9 @@ private:
     typedef variate_generator< engine_type, uniform_distribution_type > uniform_rng_type;
 
 private:
-    engine_type         _eng;
     distribution_type   _dist;
-    
-    uniform_distribution_type _uniform_distribution;
+
+    // the engine is held (or referenced) only here
     uniform_rng_type     _uniform_rng;
     bool                _valid;
 
@@ -8,48 +8,111 @@
 
 #include <qfcl/random/distribution/uniform_0ex_1ex.hpp>
 #include <qfcl/random/variate_generator.hpp>
+#include <qfcl/utility/simd.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 namespace qfcl {
 namespace random {
 
+//! accuracy tiers of the inverse of the normal cdf, for \c normal_inversion_distribution
+namespace inversion {
+
+//! Wichura's PPND7 in single precision, with relative error below 5e-7
+struct fast {};
+//! Acklam's approximation, with relative error 1.15e-9 (the default)
+struct acklam {};
+//! Wichura's AS241, with relative error about 1e-16 even in the far tails
+struct as241 {};
+
+}
+
 namespace detail {
 
-    double normal_inv(double p)
-    {
-        const double A1 = -3.969683028665376e+01;
-        const double A2 =  2.209460984245205e+02;
-        const double A3 = -2.759285104469687e+02;
-        const double A4 =  1.383577518672690e+02;
-        const double A5 = -3.066479806614716e+01;
-        const double A6 =  2.506628277459239e+00;
-        
-        const double B1 = -5.447609879822406e+01;
-        const double B2 =  1.615858368580409e+02;
-        const double B3 = -1.556989798598866e+02;
-        const double B4 =  6.680131188771972e+01;
-        const double B5 = -1.328068155288572e+01;
-        
-        const double C1 = -7.784894002430293e-03;
-        const double C2 = -3.223964580411365e-01;
-        const double C3 = -2.400758277161838e+00;
-        const double C4 = -2.549732539343734e+00;
-        const double C5 =  4.374664141464968e+00;
-        const double C6 =  2.938163982698783e+00;
-        
-        const double D1 =  7.784695709041462e-03;
-        const double D2 =  3.224671290700398e-01;
-        const double D3 =  2.445134137142996e+00;
-        const double D4 =  3.754408661907416e+00;
-        
-        const double P_LOW =    0.02425;
-        const double P_HIGH =   0.97575; // P_high = 1 - p_low;
+// coefficients of Acklam's rational approximations
+namespace normal_inv_coefficients {
+
+    const double A1 = -3.969683028665376e+01;
+    const double A2 =  2.209460984245205e+02;
+    const double A3 = -2.759285104469687e+02;
+    const double A4 =  1.383577518672690e+02;
+    const double A5 = -3.066479806614716e+01;
+    const double A6 =  2.506628277459239e+00;
+    
+    const double B1 = -5.447609879822406e+01;
+    const double B2 =  1.615858368580409e+02;
+    const double B3 = -1.556989798598866e+02;
+    const double B4 =  6.680131188771972e+01;
+    const double B5 = -1.328068155288572e+01;
+    
+    const double C1 = -7.784894002430293e-03;
+    const double C2 = -3.223964580411365e-01;
+    const double C3 = -2.400758277161838e+00;
+    const double C4 = -2.549732539343734e+00;
+    const double C5 =  4.374664141464968e+00;
+    const double C6 =  2.938163982698783e+00;
+    
+    const double D1 =  7.784695709041462e-03;
+    const double D2 =  3.224671290700398e-01;
+    const double D3 =  2.445134137142996e+00;
+    const double D4 =  3.754408661907416e+00;
     
+    const double P_LOW =    0.02425;
+    const double P_HIGH =   0.97575; // P_high = 1 - p_low;
+
+    // for the vectorized version, in the order used by simd::polynomial
+    const double A[] = {A1, A2, A3, A4, A5, A6};
+    const double B[] = {B1, B2, B3, B4, B5, 1};
+    const double C[] = {C1, C2, C3, C4, C5, C6};
+    const double D[] = {D1, D2, D3, D4, 1};
+
+    // M. Wichura, "Algorithm AS 241: The percentage points of the normal distribution" (PPND16),
+    // highest degree first: the central region |p - 1/2| <= 0.425,
+    const double AS241_A[] = {2.5090809287301226727e+3, 3.3430575583588128105e+4, 6.7265770927008700853e+4, 4.5921953931549871457e+4,
+                              1.3731693765509461125e+4, 1.9715909503065514427e+3, 1.3314166789178437745e+2, 3.3871328727963666080e+0};
+    const double AS241_B[] = {5.2264952788528545610e+3, 2.8729085735721942674e+4, 3.9307895800092710610e+4, 2.1213794301586595867e+4,
+                              5.3941960214247511077e+3, 6.8718700749205790830e+2, 4.2313330701600911252e+1, 1};
+    // the intermediate tail sqrt(-log(min(p, 1 - p))) <= 5,
+    const double AS241_C[] = {7.74545014278341407640e-4, 2.27238449892691845833e-2, 2.41780725177450611770e-1, 1.27045825245236838258e+0,
+                              3.64784832476320460504e+0, 5.76949722146069140550e+0, 4.63033784615654529590e+0, 1.42343711074968357734e+0};
+    const double AS241_D[] = {1.05075007164441684324e-9, 5.47593808499534494600e-4, 1.51986665636164571966e-2, 1.48103976427480074590e-1,
+                              6.89767334985100004550e-1, 1.67638483018380384940e+0, 2.05319162663775882187e+0, 1};
+    // and the far tail
+    const double AS241_E[] = {2.01033439929228813265e-7, 2.71155556874348757815e-5, 1.24266094738807843860e-3, 2.65321895265761230930e-2,
+                              2.96560571828504891230e-1, 1.78482653991729133580e+0, 5.46378491116411436990e+0, 6.65790464350110377720e+0};
+    const double AS241_F[] = {2.04426310338993978564e-15, 1.42151175831644588870e-7, 1.84631831751005468180e-5, 7.86869131145613259100e-4,
+                              1.48753612908506148525e-2, 1.36929880922735805310e-1, 5.99832206555887937690e-1, 1};
+
+    // the corresponding coefficients of PPND7, accurate to about 1e-7
+    const double PPND7_A[] = {5.9109374720e+01, 1.5929113202e+02, 5.0434271938e+01, 3.3871327179e+00};
+    const double PPND7_B[] = {6.7187563600e+01, 7.8757757664e+01, 1.7895169469e+01, 1};
+    const double PPND7_C[] = {1.7023821103e-01, 1.3067284816e+00, 2.7568153900e+00, 1.4234372777e+00};
+    const double PPND7_D[] = {1.2021132975e-01, 7.3700164250e-01, 1};
+    const double PPND7_E[] = {1.7337203997e-02, 4.2868294337e-01, 3.0812263860e+00, 6.6579051150e+00};
+    const double PPND7_F[] = {1.2258202635e-02, 2.4197894225e-01, 1};
+
+    // Horner's rule with the coefficients in the order above
+    template<typename RealType, std::size_t N>
+    inline RealType polynomial(RealType x, const double (&c)[N])
+    {
+        RealType y = static_cast<RealType>(c[0]);
+        for (std::size_t i = 1; i < N; ++i)
+            y = y * x + static_cast<RealType>(c[i]);
+
+        return y;
+    }
+}
+
+    inline double normal_inv(double p)
+    {
+        using namespace normal_inv_coefficients;
+
         double x;
         double q, r;
     
         if ((0.0 < p )  && (p < P_LOW)) {
-            q = sqrt(-2*log(p));
+            q = std::sqrt(-2*std::log(p));
             x = (((((C1*q+C2)*q+C3)*q+C4)*q+C5)*q+C6) / ((((D1*q+D2)*q+D3)*q+D4)*q+1);
         } else {
             if ((P_LOW <= p) && (p <= P_HIGH)){
@@ -58,7 +121,7 @@ namespace detail {
                x = (((((A1*r+A2)*r+A3)*r+A4)*r+A5)*r+A6)*q /(((((B1*r+B2)*r+B3)*r+B4)*r+B5)*r+1);
             } else {
                 if ((P_HIGH < p)&&(p < 1.0)){
-                    q = sqrt(-2*std::log(1-p));
+                    q = std::sqrt(-2*std::log(1-p));
                     x = -(((((C1*q+C2)*q+C3)*q+C4)*q+C5)*q+C6) / ((((D1*q+D2)*q+D3)*q+D4)*q+1);
                 }
             }
@@ -67,9 +130,271 @@ namespace detail {
         return x;
     }
 
+    // Wichura's approximations, with the coefficients of AS241 or PPND7 (which all are positive, so that
+    // there is no cancellation even in single precision)
+    template<typename RealType, std::size_t NA, std::size_t NB, std::size_t NC, std::size_t ND, std::size_t NE, std::size_t NF>
+    inline RealType wichura(RealType p, const double (&a)[NA], const double (&b)[NB], const double (&c)[NC], 
+                            const double (&d)[ND], const double (&e)[NE], const double (&f)[NF])
+    {
+        using normal_inv_coefficients::polynomial;
+
+        const RealType q = p - RealType(0.5);
+        if (std::fabs(q) <= RealType(0.425))
+        {
+            const RealType r = RealType(0.180625) - q * q;
+            return q * polynomial(r, a) / polynomial(r, b);
+        }
+
+        RealType r = std::sqrt( -std::log(q < 0 ? p : 1 - p) );
+        RealType x;
+        if (r <= 5)
+        {
+            r -= RealType(1.6);
+            x = polynomial(r, c) / polynomial(r, d);
+        }
+        else
+        {
+            r -= 5;
+            x = polynomial(r, e) / polynomial(r, f);
+        }
+
+        return q < 0 ? -x : x;
+    }
+
+    // the AS241 approximation, with relative error about 1e-16
+    inline double normal_inv(double p, inversion::as241)
+    {
+        using namespace normal_inv_coefficients;
+
+        return wichura(p, AS241_A, AS241_B, AS241_C, AS241_D, AS241_E, AS241_F);
+    }
+
+    // the PPND7 approximation in single precision, with relative error below 5e-7 for p >= FLT_MIN
+    inline float normal_inv_fast(float p)
+    {
+        using namespace normal_inv_coefficients;
+
+        return wichura(p, PPND7_A, PPND7_B, PPND7_C, PPND7_D, PPND7_E, PPND7_F);
+    }
+
+    inline double normal_inv(double p, inversion::acklam) {return normal_inv(p);}
+
+    // the tail is chosen before narrowing, as p > 1 - 2^-25 rounds to 1 in single precision
+    inline double normal_inv(double p, inversion::fast)
+    {
+        const float x = normal_inv_fast( static_cast<float>(p > 0.5 ? 1 - p : p) );
+
+        return p > 0.5 ? -x : x;
+    }
+
+    // the inverse of the standard normal cdf for each lane of p, with the accuracy of Tier
+    template<typename Ops, typename Tier>
+    struct normal_inv_lanes;
+
+    template<typename Ops>
+    struct normal_inv_lanes<Ops, inversion::acklam>
+    {
+        typedef typename Ops::vector vector;
+        typedef typename Ops::value_type RealType;
+
+        static vector apply(vector p)
+        {
+            using namespace normal_inv_coefficients;
+
+            const vector half = Ops::set1( RealType(0.5) );
+            const vector one = Ops::set1( RealType(1) );
+
+            // central region
+            const vector q = Ops::sub(p, half);
+            const vector r = Ops::mul(q, q);
+            vector x = Ops::div( Ops::mul( simd::polynomial<Ops>(r, A), q ), simd::polynomial<Ops>(r, B) );
+
+            // tails, blended into the lanes with min(p, 1 - p) < P_LOW
+            const vector t = Ops::min_( p, Ops::sub(one, p) );
+            const typename Ops::mask tail = Ops::less( t, Ops::set1( RealType(P_LOW) ) );
+            
+            // most vectors have no lanes in the tails (over 80% of them for 4 lanes)
+            if ( Ops::any(tail) )
+                x = Ops::select( tail, tail_value( p, simd::log<Ops>(t) ), x );
+
+            return x;
+        }
+
+        // the tail approximation, given log(min(p, 1 - p))
+        static vector tail_value(vector p, vector log_t)
+        {
+            using namespace normal_inv_coefficients;
+
+            const vector s = Ops::sqrt( Ops::mul( Ops::set1( RealType(-2) ), log_t ) );
+            const vector y = Ops::div( simd::polynomial<Ops>(s, C), simd::polynomial<Ops>(s, D) );
+            
+            return Ops::select( Ops::less( Ops::set1( RealType(0.5) ), p ), Ops::sub( Ops::set1( RealType(0) ), y ), y );
+        }
+    };
+
+    // the vectorized wichura
+    template<typename Ops, std::size_t NA, std::size_t NB, std::size_t NC, std::size_t ND, std::size_t NE, std::size_t NF>
+    inline typename Ops::vector wichura_lanes(typename Ops::vector p, const double (&a)[NA], const double (&b)[NB], 
+        const double (&c)[NC], const double (&d)[ND], const double (&e)[NE], const double (&f)[NF])
+    {
+        typedef typename Ops::vector vector;
+        typedef typename Ops::value_type RealType;
+
+        const vector half = Ops::set1( RealType(0.5) );
+
+        const vector q = Ops::sub(p, half);
+        const vector r = Ops::sub( Ops::set1( RealType(0.180625) ), Ops::mul(q, q) );
+        vector x = Ops::div( Ops::mul( q, simd::polynomial<Ops>(r, a) ), simd::polynomial<Ops>(r, b) );
+
+        // tails, blended into the lanes with min(p, 1 - p) < 0.075
+        const vector t = Ops::min_( p, Ops::sub( Ops::set1( RealType(1) ), p ) );
+        const typename Ops::mask tail = Ops::less( t, Ops::set1( RealType(0.075) ) );
+
+        if ( Ops::any(tail) )
+        {
+            const vector s = Ops::sqrt( Ops::sub( Ops::set1( RealType(0) ), simd::log<Ops>(t) ) );
+
+            const vector s1 = Ops::sub( s, Ops::set1( RealType(1.6) ) );
+            vector y = Ops::div( simd::polynomial<Ops>(s1, c), simd::polynomial<Ops>(s1, d) );
+
+            // only below about 1.4e-11
+            const typename Ops::mask far = Ops::less( Ops::set1( RealType(5) ), s );
+            if ( Ops::any(far) )
+            {
+                const vector s5 = Ops::sub( s, Ops::set1( RealType(5) ) );
+                y = Ops::select( far, Ops::div( simd::polynomial<Ops>(s5, e), simd::polynomial<Ops>(s5, f) ), y );
+            }
+
+            y = Ops::select( Ops::less(p, half), Ops::sub( Ops::set1( RealType(0) ), y ), y );
+            x = Ops::select(tail, y, x);
+        }
+
+        return x;
+    }
+
+    template<typename Ops>
+    struct normal_inv_lanes<Ops, inversion::fast>
+    {
+        static typename Ops::vector apply(typename Ops::vector p)
+        {
+            using namespace normal_inv_coefficients;
+
+            return wichura_lanes<Ops>(p, PPND7_A, PPND7_B, PPND7_C, PPND7_D, PPND7_E, PPND7_F);
+        }
+    };
+
+    template<typename Ops>
+    struct normal_inv_lanes<Ops, inversion::as241>
+    {
+        static typename Ops::vector apply(typename Ops::vector p)
+        {
+            using namespace normal_inv_coefficients;
+
+            return wichura_lanes<Ops>(p, AS241_A, AS241_B, AS241_C, AS241_D, AS241_E, AS241_F);
+        }
+    };
+
+    // applies the vectorized normal_inv, or the scalar one if there is no SIMD support
+    template<typename Ops, typename Tier>
+    struct normal_inv_batch
+    {
+        template<typename RealType>
+        static void apply(const RealType * u, RealType * z, std::size_t n)
+        {
+            const std::size_t lanes = Ops::lanes;
+
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes)
+                Ops::store( z + i, normal_inv_lanes<Ops, Tier>::apply( Ops::load(u + i) ) );
+
+            // pad the remainder, so that it gets exactly the same treatment
+            if (i < n)
+            {
+                RealType in[lanes], out[lanes];
+                std::fill( in, in + lanes, RealType(0.5) );
+                std::copy( u + i, u + n, in );
+
+                Ops::store( out, normal_inv_lanes<Ops, Tier>::apply( Ops::load(in) ) );
+                std::copy( out, out + (n - i), z + i );
+            }
+        }
+    };
+
+    template<typename Tier>
+    struct normal_inv_batch<void, Tier>
+    {
+        template<typename RealType>
+        static void apply(const RealType * u, RealType * z, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                z[i] = static_cast<RealType>( normal_inv( static_cast<double>(u[i]), Tier() ) );
+        }
+    };
+
+    /*  Batch inversion of the standard normal cdf: z[i] = normal_inv(u[i], Tier()) for i < n, for u[i] in (0, 1).
+        Uses the widest available SIMD instructions (see qfcl/utility/simd.hpp) and agrees with the scalar 
+        normal_inv to within the accuracy of Tier, except that u[i] must be a normal floating point number. 
+        z may be the same as u.
+    */
+    template<typename Tier>
+    inline void normal_inv(const double * u, double * z, std::size_t n, Tier)
+    {
+        normal_inv_batch< simd::real_ops<double>::type, Tier >::apply(u, z, n);
+    }
+
+    // the fast tier computes in single precision
+    inline void normal_inv(const float * u, float * z, std::size_t n, inversion::fast)
+    {
+        normal_inv_batch< simd::real_ops<float>::type, inversion::fast >::apply(u, z, n);
+    }
+
+    inline void normal_inv(const double * u, double * z, std::size_t n, inversion::fast)
+    {
+        float block[256];
+
+        for (std::size_t i = 0; i < n; i += 256)
+        {
+            const std::size_t m = n - i < 256 ? n - i : 256;
+            // the lower tail of min(u, 1 - u), as for the scalar version
+            for (std::size_t j = 0; j < m; ++j)
+                block[j] = static_cast<float>(u[i + j] > 0.5 ? 1 - u[i + j] : u[i + j]);
+            normal_inv(block, block, m, inversion::fast());
+            for (std::size_t j = 0; j < m; ++j)
+                z[i + j] = u[i + j] > 0.5 ? -block[j] : block[j];
+        }
+    }
+
+    // the double precision tiers, for single precision input
+    template<typename Tier>
+    inline void normal_inv(const float * u, float * z, std::size_t n, Tier)
+    {
+        double block[256];
+
+        for (std::size_t i = 0; i < n; i += 256)
+        {
+            const std::size_t m = n - i < 256 ? n - i : 256;
+            std::copy(u + i, u + i + m, block);
+            normal_inv(block, block, m, Tier());
+            std::copy(block, block + m, z + i);
+        }
+    }
+
+    // Acklam's approximation, with relative error 1.15e-9
+    inline void normal_inv(const double * u, double * z, std::size_t n)
+    {
+        normal_inv(u, z, n, inversion::acklam());
+    }
+
+    // the single precision version, with relative error below 5e-7
+    inline void normal_inv(const float * u, float * z, std::size_t n)
+    {
+        normal_inv(u, z, n, inversion::fast());
+    }
+
 }
 
-template<class RealType = double>
+// Accuracy is one of the tiers in the namespace inversion
+template<class RealType = double, class Accuracy = inversion::acklam>
 struct normal_inversion_distribution 
 { 
 	typedef RealType result_type; 
@@ -83,8 +408,8 @@ struct normal_inversion_distribution
 };
 
 //  Specialization for standard normal distribution
-template<typename RealType = double>
-struct std_normal_inversion_distribution : normal_inversion_distribution<RealType>
+template<typename RealType = double, class Accuracy = inversion::acklam>
+struct std_normal_inversion_distribution : normal_inversion_distribution<RealType, Accuracy>
 {
 };
 
@@ -92,25 +417,25 @@ struct std_normal_inversion_distribution : normal_inversion_distribution<RealTyp
 typedef normal_inversion_distribution<double> normal_inversion;
 typedef std_normal_inversion_distribution<double> std_normal_inversion;
 
-template<class Engine, class RealType >
-class variate_generator<Engine, normal_inversion_distribution<RealType> >
+template<class Engine, class RealType, class Accuracy >
+class variate_generator<Engine, normal_inversion_distribution<RealType, Accuracy> >
 {
 public:
-	typedef Engine									engine_type;
-	typedef normal_inversion_distribution<RealType>	distribution_type;
+	typedef Engine												engine_type;
+	typedef normal_inversion_distribution<RealType, Accuracy>	distribution_type;
     typedef RealType								result_type;
     
 
 public:
     // constructor
-    variate_generator(engine_type e, distribution_type d)
-    : _eng(e), _dist(d), _uniform_rng(e,_uniform_distribution)
+    variate_generator(const engine_type & e, const distribution_type & d)
+    : _dist(d), _uniform_rng(e, uniform_distribution_type())
     {
     }
     
     result_type operator()() 
     {
-		return _dist.mu + _dist.sigma * detail::normal_inv( _uniform_rng() );
+		return _dist.mu + _dist.sigma * static_cast<RealType>( detail::normal_inv( _uniform_rng(), Accuracy() ) );
     }
 
 private:
@@ -118,33 +443,32 @@ private:
     typedef variate_generator< engine_type, uniform_distribution_type > uniform_rng_type;
 
 private:
-    typename engine_type         _eng;
-    typename distribution_type   _dist;
-    
-    uniform_distribution_type _uniform_distribution;
+    distribution_type   _dist;
+
+    // the engine is held (or referenced) only here
     uniform_rng_type     _uniform_rng;
 };
 
 // specialized version for (possibly) better performance
-template<class Engine, class RealType >
-class variate_generator<Engine, std_normal_inversion_distribution<RealType> >
+template<class Engine, class RealType, class Accuracy >
+class variate_generator<Engine, std_normal_inversion_distribution<RealType, Accuracy> >
 {
 public:
-	typedef Engine									engine_type;
-	typedef normal_inversion_distribution<RealType>	distribution_type;
+	typedef Engine												engine_type;
+	typedef normal_inversion_distribution<RealType, Accuracy>	distribution_type;
     typedef RealType								result_type;
     
 
 public:
     // constructor
-    variate_generator(engine_type e, distribution_type d)
-    : _eng(e), _dist(d), _uniform_rng(e,_uniform_distribution)
+    variate_generator(const engine_type & e, const distribution_type & d)
+    : _dist(d), _uniform_rng(e, uniform_distribution_type())
     {
     }
     
     result_type operator()() 
     {
-		return detail::normal_inv( _uniform_rng() );
+		return static_cast<RealType>( detail::normal_inv( _uniform_rng(), Accuracy() ) );
     }
 
 private:
@@ -152,12 +476,42 @@ private:
     typedef variate_generator< engine_type, uniform_distribution_type > uniform_rng_type;
 
 private:
-    typename engine_type         _eng;
-    typename distribution_type   _dist;
-    
-    uniform_distribution_type _uniform_distribution;
+    distribution_type   _dist;
+
+    // the engine is held (or referenced) only here
     uniform_rng_type     _uniform_rng;
 };
 
+// inverts a block of uniforms at once with the batch normal_inv, for buffered_variate_generator
+template<class RealType, class Accuracy>
+struct block_transform< normal_inversion_distribution<RealType, Accuracy> >
+{
+    static const bool supported = true;
+
+    template<class UIntType>
+    static void apply(const normal_inversion_distribution<RealType, Accuracy> & d, const UIntType * x, RealType * z, std::size_t n, 
+        UIntType min_, UIntType max_)
+    {
+        block_transform< uniform_0ex_1ex<RealType> >::apply( uniform_0ex_1ex<RealType>(), x, z, n, min_, max_ );
+        detail::normal_inv( z, z, n, Accuracy() );
+        for (std::size_t i = 0; i < n; ++i)
+            z[i] = d.mu + d.sigma * z[i];
+    }
+};
+
+template<class RealType, class Accuracy>
+struct block_transform< std_normal_inversion_distribution<RealType, Accuracy> >
+{
+    static const bool supported = true;
+
+    template<class UIntType>
+    static void apply(const std_normal_inversion_distribution<RealType, Accuracy> &, const UIntType * x, RealType * z, std::size_t n, 
+        UIntType min_, UIntType max_)
+    {
+        block_transform< uniform_0ex_1ex<RealType> >::apply( uniform_0ex_1ex<RealType>(), x, z, n, min_, max_ );
+        detail::normal_inv( z, z, n, Accuracy() );
+    }
+};
+
 }} // namespaces
 #endif
@@ -0,0 +1,264 @@
+/* qfcl/random/distribution/poisson.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_DISTRIBUTION_POISSON_HPP
+#define QFCL_RANDOM_DISTRIBUTION_POISSON_HPP
+
+/*! \file qfcl/random/distribution/poisson.hpp
+	\brief The Poisson distribution, by inversion for small means and by PTRS for large ones
+
+	For a mean \f$\lambda < 10\f$ the cdf is tabulated on construction, together with a guide table
+	(Chen and Asau) giving the starting point of the search for each of \c guide_size intervals of
+	the uniform, so that a variate takes one uniform and typically one or two comparisons. For
+	\f$\lambda \ge 10\f$ the transformed rejection method with squeeze PTRS of W. H&ouml;rmann,
+	The transformed rejection method for generating Poisson random variables, Insurance: Mathematics
+	and Economics 12 (1993), is used, which takes two uniforms and is accepted by the squeeze, with
+	no logarithms, most of the time; otherwise \f$\log k!\f$ comes from a table for \f$k < 256\f$ and
+	from Stirling's series beyond.
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <qfcl/random/distribution/random_bits.hpp>
+#include <qfcl/random/variate_generator.hpp>
+#include <boost/cstdint.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace qfcl {
+namespace random {
+
+//! the Poisson distribution with mean \c mean
+template<class IntType = int, class RealType = double>
+struct poisson_distribution
+{
+    typedef IntType result_type;
+
+    explicit poisson_distribution(RealType mean_ = 1) : mean(mean_) {}
+
+    RealType mean;
+};
+
+namespace detail {
+
+//! the values of \f$\log k!\f$ for small \f$k\f$
+struct log_factorial_table
+{
+    static const std::size_t size = 256;
+
+    //! the table, computed on first use
+    static const log_factorial_table & get()
+    {
+        static const log_factorial_table table;
+        return table;
+    }
+
+    double value[size];
+private:
+    log_factorial_table()
+    {
+        value[0] = 0;
+        for (std::size_t i = 1; i < size; ++i)
+            value[i] = value[i - 1] + std::log( static_cast<double>(i) );
+    }
+};
+
+//! \f$\log k!\f$ for a nonnegative integer \p k
+inline double log_factorial(double k)
+{
+    if (k < log_factorial_table::size)
+        return log_factorial_table::get().value[ static_cast<std::size_t>(k) ];
+
+    // Stirling's series for log Gamma(k + 1)
+    const double x = k + 1, y = 1 / (x * x);
+    return (x - 0.5) * std::log(x) - x + 0.91893853320467274 + (1.0/12 - y * (1.0/360 - y / 1260)) / x;
+}
+
+//! draws Poisson variates from an engine
+template<typename IntType, typename RealType>
+class poisson_sampler
+{
+public:
+    // the uniforms are in double precision
+    typedef boost::uint64_t UIntType;
+
+    //! the means below this are done by inversion
+    static double inversion_limit() {return 10;}
+
+    //! the number of intervals of the guide table
+    static const std::size_t guide_size = 32;
+
+    /*! \brief The constants for the mean \p lambda
+
+        With \p tabulate false, small means are inverted by a sequential search instead, so that
+        the constructor takes no more than a few arithmetic operations, for a mean that changes with
+        every variate.
+    */
+    explicit poisson_sampler(RealType lambda, bool tabulate = true)
+    : _lambda(lambda)
+    {
+        if (lambda < inversion_limit())
+        {
+            _exp_minus_lambda = std::exp(-static_cast<double>(lambda));
+            if (tabulate)
+                make_table();
+        }
+        else
+        {
+            const double slam = std::sqrt( static_cast<double>(lambda) );
+            _log_lambda = std::log( static_cast<double>(lambda) );
+            _b = 0.931 + 2.53 * slam;
+            _a = -0.059 + 0.02483 * _b;
+            _log_inverse_alpha = std::log( 1.1239 + 1.1328 / (_b - 3.4) );
+            _vr = 0.9277 - 3.6224 / (_b - 2);
+        }
+    }
+
+    //! the engine \p e has \p bits_per_call random bits per output
+    template<class Engine>
+    IntType operator()(Engine & e, unsigned bits_per_call) const
+    {
+        if (_lambda >= inversion_limit())
+            return ptrs(e, bits_per_call);
+
+        const double u = random_unit<double, UIntType>(e, bits_per_call);
+
+        if ( _cdf.empty() )
+        {
+            double p = _exp_minus_lambda, cdf = p;
+            IntType k = 0;
+            // the terms eventually underflow, and then the sum is within rounding of 1
+            while (u >= cdf && p > 0)
+            {
+                ++k;
+                p *= _lambda / k;
+                cdf += p;
+            }
+            return k;
+        }
+
+        std::size_t k = _guide[ static_cast<std::size_t>(u * guide_size) ];
+        while (k + 1 < _cdf.size() && u >= _cdf[k])
+            ++k;
+
+        return static_cast<IntType>(k);
+    }
+private:
+    void make_table()
+    {
+        double p = _exp_minus_lambda, cdf = p;
+        _cdf.push_back(cdf);
+        // until the cdf rounds to its limit; the remaining probability is at most a few ulps
+        for (double k = 1; p > 0; ++k)
+        {
+            p *= _lambda / k;
+            const double next = cdf + p;
+            if (next == cdf)
+                break;
+            _cdf.push_back(cdf = next);
+        }
+
+        // _guide[j] is the smallest k with cdf(k) > j / guide_size
+        _guide.resize(guide_size);
+        std::size_t k = 0;
+        for (std::size_t j = 0; j < guide_size; ++j)
+        {
+            while (k + 1 < _cdf.size() && _cdf[k] <= static_cast<double>(j) / guide_size)
+                ++k;
+            _guide[j] = k;
+        }
+    }
+
+    template<class Engine>
+    IntType ptrs(Engine & e, unsigned bits_per_call) const
+    {
+        for (;;)
+        {
+            const double U = random_unit<double, UIntType>(e, bits_per_call) - 0.5;
+            const double V = random_unit<double, UIntType>(e, bits_per_call);
+            const double us = 0.5 - std::fabs(U);
+            if (us == 0)
+                continue;
+
+            const double k = std::floor( (2 * _a / us + _b) * U + _lambda + 0.43 );
+            if (us >= 0.07 && V <= _vr)
+                return static_cast<IntType>(k);
+            if ( k < 0 || (us < 0.013 && V > us) )
+                continue;
+            if ( std::log(V) + _log_inverse_alpha - std::log(_a / (us * us) + _b) <= -_lambda + k * _log_lambda - log_factorial(k) )
+                return static_cast<IntType>(k);
+        }
+    }
+
+    double _lambda;
+
+    // inversion
+    double _exp_minus_lambda;
+    std::vector<double> _cdf;
+    std::vector<std::size_t> _guide;
+
+    // PTRS
+    double _log_lambda;
+    double _a;
+    double _b;
+    double _log_inverse_alpha;
+    double _vr;
+};
+
+} // namespace detail
+
+template<class Engine, class IntType, class RealType>
+class variate_generator<Engine, poisson_distribution<IntType, RealType> >
+{
+public:
+    typedef Engine                                  engine_type;
+    typedef poisson_distribution<IntType, RealType> distribution_type;
+    typedef IntType                                 result_type;
+
+public:
+    // constructor
+    variate_generator(const engine_type & e, const distribution_type & d)
+    : _eng(e), _dist(d), _bits_per_call( detail::engine_bits(_eng) ), _sampler(d.mean)
+    {
+    }
+
+    result_type operator()()
+    {
+        return _sampler(_eng, _bits_per_call);
+    }
+
+    //! write the next \p n variates to \p dest, and return the end of the output
+    template<typename OutIt>
+    OutIt generate(OutIt dest, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i, ++dest)
+            *dest = _sampler(_eng, _bits_per_call);
+
+        return dest;
+    }
+
+    //! a variate for each of the \p n means \p mean[i], written to \p dest[i]
+    void generate(const RealType * mean, IntType * dest, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            dest[i] = detail::poisson_sampler<IntType, RealType>(mean[i], false)(_eng, _bits_per_call);
+    }
+
+private:
+    engine_type         _eng;
+    distribution_type   _dist;
+
+    unsigned            _bits_per_call;
+    detail::poisson_sampler<IntType, RealType> _sampler;
+};
+
+}} // namespaces
+#endif
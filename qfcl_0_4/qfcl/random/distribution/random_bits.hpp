@@ -0,0 +1,125 @@
+/* qfcl/random/distribution/random_bits.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_DISTRIBUTION_RANDOM_BITS_HPP
+#define QFCL_RANDOM_DISTRIBUTION_RANDOM_BITS_HPP
+
+/*! \file qfcl/random/distribution/random_bits.hpp
+    \brief Random bits and words of a given width from the outputs of an engine
+
+    \author agent
+    \date October 17, 2026
+*/
+
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include <boost/cstdint.hpp>
+
+namespace qfcl {
+namespace random {
+namespace detail {
+
+//! the number of bits of \p range, i.e. of random bits in outputs in <tt>[min, min + range]</tt> when <tt>range + 1</tt> is a power of 2
+inline unsigned range_bits(unsigned long long range)
+{
+    unsigned bits = 0;
+    for (; range != 0; range >>= 1)
+        ++bits;
+
+    return bits;
+}
+
+//! the number of random bits in each output of \p e, assuming that <tt>max() - min() + 1</tt> is a power of 2
+template<class Engine>
+unsigned engine_bits(Engine & e)
+{
+    return range_bits( static_cast<unsigned long long>( (e.max)() - (e.min)() ) );
+}
+
+//! a random \p UIntType from one or more outputs of \p e, which each have \p bits_per_call random bits
+template<typename UIntType, class Engine>
+inline UIntType random_bits(Engine & e, unsigned bits_per_call)
+{
+    static const unsigned width = sizeof(UIntType) * CHAR_BIT;
+
+    UIntType x = static_cast<UIntType>( e() - (e.min)() );
+    if (bits_per_call >= width)
+        return x;
+
+    // the usual case of a 32 bit engine and 64 bits
+    if (2 * bits_per_call >= width)
+        return (x << bits_per_call) | static_cast<UIntType>( e() - (e.min)() );
+
+    for (unsigned bits = bits_per_call; bits < width; bits += bits_per_call)
+        x = (x << bits_per_call) | static_cast<UIntType>( e() - (e.min)() );
+
+    return x;
+}
+
+//! a uniform random number in [0, 1) with the precision of \p RealType
+template<typename RealType, typename UIntType, class Engine>
+inline RealType random_unit(Engine & e, unsigned bits_per_call)
+{
+    static const int digits = std::numeric_limits<RealType>::digits;
+    static const int shift = static_cast<int>(sizeof(UIntType) * CHAR_BIT) > digits ? static_cast<int>(sizeof(UIntType) * CHAR_BIT) - digits : 0;
+
+    return static_cast<RealType>( random_bits<UIntType>(e, bits_per_call) >> shift ) * static_cast<RealType>( std::ldexp(1.0, -(static_cast<int>(sizeof(UIntType) * CHAR_BIT) - shift)) );
+}
+
+//! the number of engine outputs of type \p UIntType that make up a random \p WordType
+template<typename WordType, typename UIntType>
+struct outputs_per_word
+{
+    static const std::size_t value = (sizeof(WordType) + sizeof(UIntType) - 1) / sizeof(UIntType);
+};
+
+//! the number of outputs, with \p bits random bits each, that make up \p word_bits random bits
+inline std::size_t outputs_for_bits(unsigned word_bits, unsigned bits)
+{
+    return (word_bits + bits - 1) / bits;
+}
+
+/*! \brief A random \p WordType from the \p k engine outputs <tt>x[0], ..., x[k - 1]</tt>, where each output lies in <tt>[min_, min_ + 2^bits)</tt>
+
+    With \p k at least <tt>outputs_for_bits(sizeof(WordType) * CHAR_BIT, bits)</tt> every bit of the
+    word is random, however narrow the engine; the highest bits of the last output are then dropped.
+*/
+template<typename WordType, typename UIntType>
+inline WordType random_word(const UIntType * x, UIntType min_, unsigned bits, std::size_t k)
+{
+    static const unsigned word_bits = sizeof(WordType) * CHAR_BIT;
+
+    boost::uint64_t w = 0;
+    for (std::size_t j = 0; j < k && j * bits < 64; ++j)
+        w |= static_cast<boost::uint64_t>(x[j] - min_) << (j * bits);
+    if (k * bits < 64)
+        w <<= 64 - k * bits;
+
+    return static_cast<WordType>( w >> (64 - word_bits) );
+}
+
+/*! \brief A random \p WordType from the engine outputs <tt>x[0], ..., x[K - 1]</tt>, where \c K is \c outputs_per_word,
+    which does not depend on \p bits
+
+    Each output lies in <tt>[min_, min_ + 2^bits)</tt>. The first output supplies the lowest bits, so that for
+    engines whose outputs take all values of \p UIntType this is just the outputs read as a \p WordType (on a 
+    little endian machine). The random bits are left aligned, i.e. only when the engine has fewer than 
+    <tt>sizeof(WordType) * CHAR_BIT / K</tt> bits per output are there zero bits, and they are the lowest.
+*/
+template<typename WordType, typename UIntType>
+inline WordType random_word(const UIntType * x, UIntType min_, unsigned bits)
+{
+    return random_word<WordType>( x, min_, bits, outputs_per_word<WordType, UIntType>::value );
+}
+
+}}} // namespaces
+#endif
@@ -25,7 +25,7 @@ public:
 
     // constructor
     // if, min==1, max==3 then  [ 0/3, 1/3, 2/3 ]
-    variate_generator(engine_type e, distribution_type d) : _eng(e), _dist(d)
+    variate_generator(const engine_type & e, const distribution_type & d) : _eng(e), _dist(d)
     { 
         _factor = result_type( (_eng.max)() - (_eng.min)() );
         _factor += 1;
@@ -41,5 +41,22 @@ private:
     result_type         _factor;
 };
 
+// the same transformation for a block of engine outputs, for buffered_variate_generator
+template<class RealType>
+struct block_transform< uniform_0in_1ex<RealType> >
+{
+    static const bool supported = true;
+
+    template<class UIntType>
+    static void apply(const uniform_0in_1ex<RealType> &, const UIntType * x, RealType * out, std::size_t n, UIntType min_, UIntType max_)
+    {
+        RealType factor = RealType(max_ - min_);
+        factor += 1;
+        factor = 1/factor;
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = RealType( x[i] - min_ ) * factor;
+    }
+};
+
 }} // namespaces
 #endif
@@ -25,7 +25,7 @@ public:
 
     // constructor
     // if, min==1, max==3 then  [ 0/2, 1/2, 2/2 ]
-    variate_generator(engine_type e, distribution_type d) : _eng(e), _dist(d)
+    variate_generator(const engine_type & e, const distribution_type & d) : _eng(e), _dist(d)
     {
         _factor = result_type( (_eng.max)() - (_eng.min)() );
         _factor = 1/_factor;
@@ -39,5 +39,20 @@ private:
     result_type         _factor;
 };
 
+// the same transformation for a block of engine outputs, for buffered_variate_generator
+template<class RealType>
+struct block_transform< uniform_0in_1in<RealType> >
+{
+    static const bool supported = true;
+
+    template<class UIntType>
+    static void apply(const uniform_0in_1in<RealType> &, const UIntType * x, RealType * out, std::size_t n, UIntType min_, UIntType max_)
+    {
+        const RealType factor = 1/RealType(max_ - min_);
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = RealType( x[i] - min_ ) * factor;
+    }
+};
+
 }} // namespaces
 #endif
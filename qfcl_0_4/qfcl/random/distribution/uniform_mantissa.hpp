@@ -0,0 +1,295 @@
+/* qfcl/random/distribution/uniform_mantissa.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_DISTRIBUTION_UNIFORM_MANTISSA_HPP
+#define QFCL_RANDOM_DISTRIBUTION_UNIFORM_MANTISSA_HPP
+
+/*! \file qfcl/random/distribution/uniform_mantissa.hpp
+	\brief Uniform distributions on the unit interval with full floating point resolution
+
+	The random bits are placed directly in the mantissa of a number in [1, 2), which is then shifted
+	to the unit interval, so that there is no integer to floating point conversion. A \c double has 52
+	random bits, taken from one output of a 64 bit engine, two outputs of a 32 bit engine, or as many
+	outputs of a narrower engine as make up 52 bits, and a \c float has 23. The four distributions
+	have the same endpoints as \c uniform_0ex_1ex and friends:
+	\li \c uniform_mantissa_0in_1ex: the \f$2^{52}\f$ values \f$k 2^{-52}\f$, \f$0 \le k < 2^{52}\f$
+	\li \c uniform_mantissa_0ex_1in: the values \f$k 2^{-52}\f$, \f$0 < k \le 2^{52}\f$
+	\li \c uniform_mantissa_0ex_1ex: the values \f$(k + 1/2) 2^{-52}\f$, \f$0 \le k < 2^{52}\f$
+	\li \c uniform_mantissa_0in_1in: the values \f$k 2^{-52} (1 + 2^{-52})\f$ rounded, which include 0 and 1
+	(with 23 in place of 52 for \c float). The values are exact, except for the last distribution.
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+#include <qfcl/random/distribution/random_bits.hpp>
+#include <qfcl/random/variate_generator.hpp>
+#include <qfcl/utility/simd.hpp>
+
+namespace qfcl {
+namespace random {
+
+namespace detail {
+
+//! the unsigned integer holding the bits of \p RealType, and the bits of 1
+template<typename RealType>
+struct mantissa_word
+{
+	typedef boost::uint64_t type;
+	static const type one = 0x3FF0000000000000ull;
+};
+
+template<>
+struct mantissa_word<float>
+{
+	typedef boost::uint32_t type;
+	static const type one = 0x3F800000u;
+};
+
+/*! \brief The number of engine outputs of type \p UIntType used for each uniform \p RealType
+
+	\c value outputs fill a word of the size of \p RealType. An engine with fewer random bits
+	per output takes enough outputs to fill the whole mantissa, which is \c for_bits.
+*/
+template<typename RealType, typename UIntType>
+struct mantissa_outputs
+{
+	static const std::size_t value = outputs_per_word<typename mantissa_word<RealType>::type, UIntType>::value;
+	//! the most outputs for any number of bits, which is for 1 bit
+	static const std::size_t max_value = std::numeric_limits<RealType>::digits - 1 > value 
+		? std::numeric_limits<RealType>::digits - 1 : value;
+
+	static std::size_t for_bits(unsigned bits)
+	{
+		const std::size_t k = outputs_for_bits(std::numeric_limits<RealType>::digits - 1, bits);
+		return k > value ? k : value;
+	}
+};
+
+//! the number in [1, 2) whose mantissa is the highest bits of \p w
+template<typename RealType>
+inline RealType fill_mantissa(typename mantissa_word<RealType>::type w)
+{
+	typedef mantissa_word<RealType> word;
+	static const int shift = static_cast<int>(sizeof(w) * CHAR_BIT) - (std::numeric_limits<RealType>::digits - 1);
+
+	const typename word::type bits = (w >> shift) | word::one;
+
+	RealType y;
+	std::memcpy( &y, &bits, sizeof(y) );
+	return y;
+}
+
+//! the maps from [1, 2) to the unit interval, for a scalar \c y or the lanes of a SIMD vector \c v
+struct mantissa_0in_1ex
+{
+	template<typename RealType>
+	static RealType scalar(RealType y) {return y - 1;}
+
+	template<typename Ops>
+	static typename Ops::vector lanes(typename Ops::vector v) {return Ops::sub( v, Ops::set1(1) );}
+};
+
+struct mantissa_0ex_1in
+{
+	template<typename RealType>
+	static RealType scalar(RealType y) {return 2 - y;}
+
+	template<typename Ops>
+	static typename Ops::vector lanes(typename Ops::vector v) {return Ops::sub( Ops::set1(2), v );}
+};
+
+// subtracting 1 - epsilon / 2 is exact by Sterbenz's lemma
+struct mantissa_0ex_1ex
+{
+	template<typename RealType>
+	static RealType scalar(RealType y) {return y - offset<RealType>();}
+
+	template<typename Ops>
+	static typename Ops::vector lanes(typename Ops::vector v)
+	{
+		return Ops::sub( v, Ops::set1( offset<typename Ops::value_type>() ) );
+	}
+private:
+	template<typename RealType>
+	static RealType offset() {return 1 - std::numeric_limits<RealType>::epsilon() / 2;}
+};
+
+// (1 - epsilon) * (1 + epsilon) rounds to 1
+struct mantissa_0in_1in
+{
+	template<typename RealType>
+	static RealType scalar(RealType y) {return (y - 1) * factor<RealType>();}
+
+	template<typename Ops>
+	static typename Ops::vector lanes(typename Ops::vector v)
+	{
+		return Ops::mul( Ops::sub( v, Ops::set1(1) ), Ops::set1( factor<typename Ops::value_type>() ) );
+	}
+private:
+	template<typename RealType>
+	static RealType factor() {return 1 + std::numeric_limits<RealType>::epsilon();}
+};
+
+//! the uniforms from full range engine outputs, read as words of the size of \p RealType, a SIMD vector at a time
+template<typename Ops, class Endpoints>
+struct mantissa_uniform_lanes
+{
+	//! the number of uniforms written, a multiple of \c Ops::lanes
+	template<typename RealType>
+	static std::size_t apply(const void * x, RealType * u, std::size_t n)
+	{
+		const char * p = static_cast<const char *>(x);
+
+		std::size_t i = 0;
+		for (; i + Ops::lanes <= n; i += Ops::lanes)
+			Ops::store( u + i, Endpoints::template lanes<Ops>( Ops::fill_mantissa( p + i * sizeof(RealType) ) ) );
+
+		return i;
+	}
+};
+
+template<class Endpoints>
+struct mantissa_uniform_lanes<void, Endpoints>
+{
+	template<typename RealType>
+	static std::size_t apply(const void *, RealType *, std::size_t)
+	{
+		return 0;
+	}
+};
+
+/*! \brief The uniforms \c u[i], \c i < \c n, from the engine outputs \c x, which lie in <tt>[min_, max_]</tt>
+
+	Uniform \c i uses the outputs \c x[k * i], ..., \c x[k * i + k - 1], where \c k is \c mantissa_outputs::for_bits.
+	When the outputs take all values of \p UIntType and fill a word exactly, the words are read directly
+	from \c x with SIMD instructions.
+*/
+template<class Endpoints, typename RealType, typename UIntType>
+inline void mantissa_uniforms(const UIntType * x, RealType * u, std::size_t n, UIntType min_, UIntType max_)
+{
+	typedef typename mantissa_word<RealType>::type word_type;
+	static const std::size_t K = mantissa_outputs<RealType, UIntType>::value;
+
+	const unsigned bits = range_bits( static_cast<unsigned long long>(max_ - min_) );
+	const std::size_t k = mantissa_outputs<RealType, UIntType>::for_bits(bits);
+
+	std::size_t i = 0;
+	if (K * sizeof(UIntType) == sizeof(RealType) && bits == sizeof(UIntType) * CHAR_BIT)
+		i = mantissa_uniform_lanes<typename simd::real_ops<RealType>::type, Endpoints>::apply(x, u, n);
+
+	for (; i < n; ++i)
+		u[i] = Endpoints::scalar( fill_mantissa<RealType>( random_word<word_type>(x + k * i, min_, bits, k) ) );
+}
+
+//! the \c variate_generator for all of the mantissa uniform distributions
+template<class Engine, class Distribution>
+class mantissa_variate_generator
+{
+	typedef typename boost::remove_reference<Engine>::type engine_value_type;
+	typedef typename engine_value_type::result_type engine_result_type;
+	typedef typename Distribution::endpoints endpoints;
+public:
+	typedef Engine							engine_type;
+	typedef Distribution					distribution_type;
+	typedef typename Distribution::result_type	result_type;
+
+	mantissa_variate_generator(const engine_type & e, const distribution_type & d)
+		: _eng(e), _dist(d), _bits_per_call( engine_bits(_eng) ),
+		  _outputs( mantissa_outputs<result_type, engine_result_type>::for_bits(_bits_per_call) )
+	{
+	}
+
+	result_type operator()()
+	{
+		engine_result_type x[max_outputs];
+		for (std::size_t j = 0; j < _outputs; ++j)
+			x[j] = _eng();
+
+		return endpoints::scalar( fill_mantissa<result_type>( 
+			random_word<word_type>( x, (_eng.min)(), _bits_per_call, _outputs ) ) );
+	}
+private:
+	typedef typename mantissa_word<result_type>::type word_type;
+	static const std::size_t max_outputs = mantissa_outputs<result_type, engine_result_type>::max_value;
+
+	engine_type			_eng;
+	distribution_type	_dist;
+	unsigned			_bits_per_call;
+	//! the number of engine calls per variate
+	std::size_t			_outputs;
+};
+
+//! the \c block_transform for all of the mantissa uniform distributions
+template<class Distribution>
+struct mantissa_block_transform
+{
+	static const bool supported = true;
+
+	template<class UIntType>
+	static void apply(const Distribution &, const UIntType * x, typename Distribution::result_type * u, std::size_t n,
+		UIntType min_, UIntType max_)
+	{
+		mantissa_uniforms<typename Distribution::endpoints>(x, u, n, min_, max_);
+	}
+};
+
+}	// namespace detail
+
+//! uniform on [0, 1) with full resolution
+template<class RealType = double>
+struct uniform_mantissa_0in_1ex { typedef RealType result_type; typedef detail::mantissa_0in_1ex endpoints; };
+
+//! uniform on (0, 1] with full resolution
+template<class RealType = double>
+struct uniform_mantissa_0ex_1in { typedef RealType result_type; typedef detail::mantissa_0ex_1in endpoints; };
+
+//! uniform on (0, 1) with full resolution
+template<class RealType = double>
+struct uniform_mantissa_0ex_1ex { typedef RealType result_type; typedef detail::mantissa_0ex_1ex endpoints; };
+
+//! uniform on [0, 1] with full resolution
+template<class RealType = double>
+struct uniform_mantissa_0in_1in { typedef RealType result_type; typedef detail::mantissa_0in_1in endpoints; };
+
+//! the \c variate_generator, \c block_transform and \c block_transform_outputs specializations for \p name
+#define QFCL_UNIFORM_MANTISSA_SPECIALIZATIONS(name)														\
+template<class Engine, class RealType>																	\
+class variate_generator< Engine, name<RealType> >														\
+	: public detail::mantissa_variate_generator< Engine, name<RealType> >								\
+{																										\
+public:																									\
+	variate_generator(const Engine & e, const name<RealType> & d)														\
+		: detail::mantissa_variate_generator< Engine, name<RealType> >(e, d) {}							\
+};																										\
+																										\
+template<class RealType>																				\
+struct block_transform< name<RealType> > : detail::mantissa_block_transform< name<RealType> > {};		\
+																										\
+template<class RealType, typename UIntType>																\
+struct block_transform_outputs< name<RealType>, UIntType >												\
+	: detail::mantissa_outputs<RealType, UIntType> {};
+
+QFCL_UNIFORM_MANTISSA_SPECIALIZATIONS(uniform_mantissa_0in_1ex)
+QFCL_UNIFORM_MANTISSA_SPECIALIZATIONS(uniform_mantissa_0ex_1in)
+QFCL_UNIFORM_MANTISSA_SPECIALIZATIONS(uniform_mantissa_0ex_1ex)
+QFCL_UNIFORM_MANTISSA_SPECIALIZATIONS(uniform_mantissa_0in_1in)
+
+#undef QFCL_UNIFORM_MANTISSA_SPECIALIZATIONS
+
+}} // namespaces
+#endif
@@ -0,0 +1,132 @@
+/* qfcl/random/distribution/ziggurat_table.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_DISTRIBUTION_ZIGGURAT_TABLE_HPP
+#define QFCL_RANDOM_DISTRIBUTION_ZIGGURAT_TABLE_HPP
+
+/*! \file qfcl/random/distribution/ziggurat_table.hpp
+	\brief Tables for the ziggurat method of Marsaglia and Tsang
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include <boost/cstdint.hpp>
+
+#include <qfcl/random/distribution/random_bits.hpp>
+
+namespace qfcl {
+namespace random {
+namespace detail {
+
+//! the random bits used per ziggurat variate of type \p RealType
+template<typename RealType>
+struct ziggurat_uint
+{
+    typedef boost::uint64_t type;
+};
+
+template<>
+struct ziggurat_uint<float>
+{
+    typedef boost::uint32_t type;
+};
+
+//! the right half of the standard normal density, without normalization, and the 256 layer ziggurat constants
+struct ziggurat_normal_density
+{
+    //! whether the distribution is symmetric about 0, in which case a random sign is used
+    static const bool symmetric = true;
+    //! the start of the tail
+    static double r() {return 3.6541528853610088;}
+    //! the area of each layer
+    static double v() {return 0.00492867323399;}
+
+    static double f(double x) {return std::exp(-0.5 * x * x);}
+    static double inverse(double y) {return std::sqrt( -2 * std::log(y) );}
+};
+
+//! the exponential density and the 256 layer ziggurat constants
+struct ziggurat_exponential_density
+{
+    static const bool symmetric = false;
+    static double r() {return 7.69711747013104972;}
+    static double v() {return 0.0039496598225815571993;}
+
+    static double f(double x) {return std::exp(-x);}
+    static double inverse(double y) {return -std::log(y);}
+};
+
+/*! \brief The 256 layer ziggurat for \p Density, for drawing \p RealType variates from \p UIntType random bits
+
+    The lowest \c index_bits bits of a random \p UIntType choose the layer \c i, and the highest bits 
+    give the position \c j within the layer, with \c significand_bits bits of magnitude and, if \p Density 
+    is symmetric, a sign. The variate is <tt>j * w[i]</tt>, and is accepted immediately when 
+    <tt>|j| < k[i]</tt>, which is the case about 99% of the time. The table takes 6KB for \c double,
+    so that it stays in L1 cache.
+
+    Layer 0 is the base strip, including the tail beyond \c r, and layer \c i lies between the
+    heights <tt>f[i]</tt> and <tt>f[i + 1]</tt>.
+*/
+template<class Density, typename UIntType, typename RealType>
+class ziggurat_table
+{
+public:
+    static const std::size_t layers = 256;
+    static const unsigned index_bits = 8;
+    static const unsigned sign_bits = Density::symmetric ? 1 : 0;
+    static const unsigned significand_bits =
+        sizeof(UIntType) * CHAR_BIT - index_bits - sign_bits < static_cast<unsigned>(std::numeric_limits<RealType>::digits) ?
+        sizeof(UIntType) * CHAR_BIT - index_bits - sign_bits : std::numeric_limits<RealType>::digits;
+
+    //! the table, computed on first use
+    static const ziggurat_table & get()
+    {
+        static const ziggurat_table table;
+        return table;
+    }
+
+    //! the threshold of \c j for the rectangular part of each layer
+    UIntType k[layers];
+    //! the width of each layer, divided by \f$2^{\mathrm{significand\_bits}}\f$
+    RealType w[layers];
+    //! the density at the edge of each layer
+    RealType f[layers + 1];
+private:
+    ziggurat_table()
+    {
+        const double scale = std::ldexp(1.0, significand_bits);
+
+        double x[layers + 1];
+        x[0] = Density::v() / Density::f( Density::r() );
+        x[1] = Density::r();
+        for (std::size_t i = 1; i < layers - 1; ++i)
+        {
+            const double y = Density::f(x[i]) + Density::v() / x[i];
+            x[i + 1] = y < 1 ? Density::inverse(y) : 0;
+        }
+        x[layers] = 0;
+
+        for (std::size_t i = 0; i < layers; ++i)
+        {
+            k[i] = static_cast<UIntType>( x[i + 1] / x[i] * scale );
+            w[i] = static_cast<RealType>( x[i] / scale );
+            f[i] = static_cast<RealType>( Density::f(x[i]) );
+        }
+        f[layers] = 1;
+    }
+};
+
+}}} // namespaces
+#endif
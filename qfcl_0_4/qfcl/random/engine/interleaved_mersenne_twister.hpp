@@ -0,0 +1,239 @@
+/* qfcl/random/engine/interleaved_mersenne_twister.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_RANDOM_INTERLEAVED_MERSENNE_TWISTER_HPP
+#define QFCL_RANDOM_INTERLEAVED_MERSENNE_TWISTER_HPP
+
+/*! \file qfcl/random/engine/interleaved_mersenne_twister.hpp
+	\brief Several Mersenne Twister streams generated in lockstep
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/mpl/string.hpp>
+
+#include <qfcl/utility/tmp.hpp>
+
+#include "mersenne_twister.hpp"
+
+namespace qfcl {
+
+namespace random {
+
+//! \cond
+namespace {
+
+typedef boost::mpl::string<'I', 'n', 't', 'e', 'r', 'l', 'e', 'a'>::type _interleaved_prefix1;
+typedef boost::mpl::string<'v', 'e', 'd', '-'>::type _interleaved_prefix2;
+}	// anonymous namespace
+//! \endcond
+
+/*! \ingroup random
+	@{
+*/
+
+/*! \brief \p W streams of the Mersenne Twister \p Engine, generated in lockstep
+
+	The states of the streams are stored in structure-of-arrays layout, i.e. word \c k of
+	the state of stream \c l is <tt>x[k][l]</tt>, so that the twist and the tempering are applied
+	to all of the streams at once with the SIMD operations of \c Engine::PolicyTraits.
+
+	Stream \c l starts where <tt>Engine(seed)</tt> is after discarding <tt>l * spacing</tt> numbers,
+	using the jump ahead of \c linear_generator::discard. Hence the streams do not overlap
+	for the first \c spacing numbers, and stream \c l is reproduced exactly by \c lane(l).
+
+	Each call of <tt>operator()</tt> generates the next number of every stream.
+
+	\tparam Engine a \c mersenne_twister_engine
+	\tparam W the number of streams, preferably a multiple of the SIMD vector width
+*/
+template<typename Engine, std::size_t W>
+class interleaved_mersenne_twister
+{
+public:
+	typedef typename Engine::result_type result_type;
+	typedef typename Engine::UIntType UIntType;
+	typedef Engine engine_type;
+
+	//! the number of streams
+	static const std::size_t streams = W;
+	//! the default number of numbers between the starting points of consecutive streams
+	static const unsigned long long default_spacing = 1ull << 60;
+
+	//! the streams start at <tt>Engine(seed_)</tt>, spaced \p spacing apart
+	explicit interleaved_mersenne_twister(UIntType seed_ = Engine::default_seed,
+		unsigned long long spacing = default_spacing)
+	{
+		seed(seed_, spacing);
+	}
+	//! the streams start at \p e, spaced \p spacing apart
+	explicit interleaved_mersenne_twister(const Engine & e, unsigned long long spacing = default_spacing)
+	{
+		seed(e, spacing);
+	}
+
+	//! restart the streams at <tt>Engine(seed_)</tt>, spaced \p spacing apart
+	void seed(UIntType seed_ = Engine::default_seed, unsigned long long spacing = default_spacing)
+	{
+		seed( Engine(seed_), spacing );
+	}
+	//! restart the streams at \p e, spaced \p spacing apart
+	void seed(const Engine & e, unsigned long long spacing = default_spacing)
+	{
+		Engine stream(e);
+
+		for (std::size_t l = 0; l < W; ++l)
+		{
+			if (l > 0)
+				stream.discard(spacing);
+
+			set_lane(l, stream);
+		}
+
+		p = 0;
+	}
+
+	static result_type min() {return Engine::min();}
+	static result_type max() {return Engine::max();}
+
+	//! the next number of each stream, written to <tt>dest[0], ..., dest[W - 1]</tt>, returns the end of the output
+	template<typename OutIt>
+	OutIt operator()(OutIt dest) {return generate(dest, 1);}
+
+	//! the next \p steps numbers of each stream, returns the end of the output
+	/*! The output is step major: <tt>dest[s * W + l]</tt> is number \c s of stream \c l.
+	*/
+	template<typename OutIt>
+	OutIt generate(OutIt dest, std::size_t steps)
+	{
+		while (steps > 0)
+		{
+			if (p == n)
+			{
+				twist();
+				p = 0;
+			}
+
+			// consecutive rows are contiguous, so they are tempered together
+			const std::size_t rows = steps < n - p ? steps : n - p;
+			dest = Engine::PolicyTraits::temper_block(&x[p][0], rows * W, dest);
+
+			p += rows;
+			steps -= rows;
+		}
+
+		return dest;
+	}
+
+	//! advance each stream by \p steps, using \c linear_generator::discard
+	void discard(unsigned long long steps)
+	{
+		std::vector<Engine> engines;
+		for (std::size_t l = 0; l < W; ++l)
+			engines.push_back( lane(l) );
+
+		for (std::size_t l = 0; l < W; ++l)
+		{
+			engines[l].discard(steps);
+			set_lane(l, engines[l]);
+		}
+
+		p = 0;
+	}
+
+	//! an \c Engine that generates the same numbers as stream \p l from now on
+	Engine lane(std::size_t l) const
+	{
+		if (l >= W)
+			throw std::out_of_range("interleaved_mersenne_twister: no such stream");
+
+		// the raw numbers x[p], ..., x[n - 1] of the stream, followed by the next p numbers
+		// from the recurrence x_{k + n} = twist(x_k, x_{k + 1}, x_{k + m})
+		std::vector<UIntType> y(n + p);
+		for (std::size_t k = 0; k < n; ++k)
+			y[k] = x[k][l];
+		for (std::size_t k = n; k < n + p; ++k)
+			y[k] = Engine::PolicyTraits::twist(y[k - n], y[k - n + 1], y[k - n + m]);
+
+		UIntType s[n];
+		std::copy(y.begin() + p, y.end(), s);
+
+		return Engine( typename Engine::state(s) );
+	}
+
+	friend bool operator==(const interleaved_mersenne_twister & a, const interleaved_mersenne_twister & b)
+	{
+		for (std::size_t l = 0; l < W; ++l)
+			if ( a.lane(l) != b.lane(l) )
+				return false;
+
+		return true;
+	}
+	friend bool operator!=(const interleaved_mersenne_twister & a, const interleaved_mersenne_twister & b)
+	{
+		return !(a == b);
+	}
+
+	typedef typename qfcl::tmp::concatenate<_interleaved_prefix1, _interleaved_prefix2, typename Engine::name>::type name;
+private:
+	static const std::size_t n = Engine::state_size;
+	static const std::size_t m = Engine::shift_size;
+	static const std::size_t lanes = Engine::PolicyTraits::lanes;
+
+	//! sets stream \p l to the next \c n numbers of \p e, requires <tt>p == 0</tt> afterwards
+	void set_lane(std::size_t l, const Engine & e)
+	{
+		const typename Engine::state s = e.getState();
+
+		for (std::size_t k = 0; k < n; ++k)
+			x[k][l] = s.rep()[k];
+	}
+
+	//! \c Next_n for all streams at once
+	void twist()
+	{
+		typedef typename Engine::PolicyTraits policy;
+
+		// the rows k < n - m are the interleaved equivalent of the first loop of Next_n,
+		// and the rows n - m <= k < n - 1 of the second
+		if (W * m >= lanes && W * (n - m) >= lanes)
+		{
+			policy::twist_lanes(&x[0][0], &x[1][0], &x[m][0], (n - m) * W);
+			policy::twist_lanes(&x[n - m][0], &x[n - m + 1][0], &x[0][0], (m - 1) * W);
+		}
+		else
+		{
+			for (std::size_t k = 0; k < n - m; ++k)
+				policy::twist_lanes(x[k], x[k + 1], x[k + m], W);
+			for (std::size_t k = n - m; k < n - 1; ++k)
+				policy::twist_lanes(x[k], x[k + 1], x[k - (n - m)], W);
+		}
+
+		policy::twist_lanes(x[n - 1], x[0], x[m - 1], W);
+	}
+
+	//! the states, in structure-of-arrays layout
+	UIntType x[n][W];
+	//! the row of \c x holding the next numbers to be tempered
+	std::size_t p;
+};
+
+//! @}
+
+}	// namespace random
+
+}	// namespace qfcl
+
+#endif	// QFCL_RANDOM_INTERLEAVED_MERSENNE_TWISTER_HPP
@@ -0,0 +1,296 @@
+/* qfcl/random/engine/jump_matrix_cache.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef	QFCL_RANDOM_JUMP_MATRIX_CACHE_HPP
+#define	QFCL_RANDOM_JUMP_MATRIX_CACHE_HPP
+
+/*! \file qfcl/random/engine/jump_matrix_cache.hpp
+	\brief In-memory cache of jump matrices for linear generators
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "matrix.hpp"
+
+namespace qfcl {
+
+namespace random {
+
+/*! \ingroup random
+	@{
+*/
+
+/*! \brief Thread-safe, bounded cache of jump matrices with least recently used eviction
+
+	Jump matrices are keyed by the engine name, the jump size and the direction, so a
+	single cache is shared by all linear generators. The cache holds at most
+	\c capacity() bytes of matrix data; a matrix larger than the capacity is not cached.
+*/
+class jump_matrix_cache
+{
+public:
+	typedef Matrix<2> matrix_t;
+	typedef std::shared_ptr<const matrix_t> matrix_ptr;
+
+	//! identifies a jump matrix
+	struct key_type
+	{
+		key_type(const std::string & _engine_name, unsigned long long _jump_size, bool _reverse)
+			: engine_name(_engine_name), jump_size(_jump_size), reverse(_reverse) {}
+
+		std::string engine_name;
+		unsigned long long jump_size;
+		bool reverse;
+
+		friend bool operator<(const key_type & a, const key_type & b)
+		{
+			if (a.engine_name != b.engine_name)
+				return a.engine_name < b.engine_name;
+			if (a.jump_size != b.jump_size)
+				return a.jump_size < b.jump_size;
+			return a.reverse < b.reverse;
+		}
+	};
+
+	//! default capacity in bytes, enough for several MT19937 jump matrices
+	static const std::size_t default_capacity = 256 * 1024 * 1024;
+
+	//! the cache used by all linear generators
+	static jump_matrix_cache & instance()
+	{
+		static jump_matrix_cache cache;
+		return cache;
+	}
+
+	explicit jump_matrix_cache(std::size_t _capacity = default_capacity)
+		: capacity_(_capacity), size_(0), hits_(0), misses_(0) {}
+
+	/*! \brief returns the matrix for \p key, calling \p compute to obtain it on a miss
+
+		\p compute is called without holding the lock, so that different matrices can
+		be obtained concurrently. If several threads miss on the same key, only the first
+		computes it, and the others wait for its result (or its exception).
+	*/
+	template<typename F>
+	matrix_ptr get(const key_type & key, const F & compute)
+	{
+		std::promise<matrix_ptr> promise;
+		std::shared_future<matrix_ptr> in_progress;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			matrix_ptr M = find_locked(key);
+			if (M)
+				return M;
+
+			pending_t::iterator it = pending_.find(key);
+			if ( it != pending_.end() )
+				in_progress = it->second;
+			else
+				pending_.insert( std::make_pair(key, promise.get_future().share()) );
+		}
+
+		// another thread is computing it
+		if ( in_progress.valid() )
+			return in_progress.get();
+
+		matrix_ptr M;
+		try
+		{
+			M = std::make_shared<const matrix_t>( compute() );
+		}
+		catch (...)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				pending_.erase(key);
+			}
+			promise.set_exception( std::current_exception() );
+			throw;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			insert_locked(key, M);
+			pending_.erase(key);
+		}
+		promise.set_value(M);
+
+		return M;
+	}
+
+	//! returns the matrix for \p key, or null if it is not cached
+	matrix_ptr find(const key_type & key)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		return find_locked(key);
+	}
+
+	//! adds \p M to the cache, evicting the least recently used matrices as needed
+	void insert(const key_type & key, const matrix_ptr & M)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		insert_locked(key, M);
+	}
+
+	//! remove all matrices from the cache
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		entries_.clear();
+		index_.clear();
+		size_ = 0;
+	}
+
+	//! set the maximum number of bytes of matrix data held, evicting as needed
+	void capacity(std::size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		capacity_ = bytes;
+		evict(capacity_);
+	}
+	//! the maximum number of bytes of matrix data held
+	std::size_t capacity() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return capacity_;
+	}
+	//! the number of bytes of matrix data currently held
+	std::size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return size_;
+	}
+	//! the number of cached matrices
+	std::size_t count() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return entries_.size();
+	}
+
+	//! number of lookups that found the matrix in the cache
+	unsigned long long hits() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return hits_;
+	}
+	//! number of lookups that did not find the matrix in the cache
+	unsigned long long misses() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return misses_;
+	}
+	//! reset the hit and miss counters
+	void reset_statistics()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		hits_ = misses_ = 0;
+	}
+
+	//! the number of bytes of data in \p M
+	static std::size_t size_in_bytes(const matrix_t & M)
+	{
+		return M.NumRows() > 0 ? M.NumRows() * M[0].rep.length() * sizeof(_ntl_ulong) : 0;
+	}
+private:
+	typedef std::list< std::pair<key_type, matrix_ptr> > list_t;
+	typedef std::map<key_type, list_t::iterator> index_t;
+	//! the matrices being computed, by the first thread to miss on them
+	typedef std::map< key_type, std::shared_future<matrix_ptr> > pending_t;
+
+	// not copyable
+	jump_matrix_cache(const jump_matrix_cache &);
+	jump_matrix_cache & operator=(const jump_matrix_cache &);
+
+	//! \c find, the lock must be held
+	matrix_ptr find_locked(const key_type & key)
+	{
+		index_t::iterator it = index_.find(key);
+		if ( it == index_.end() )
+		{
+			++misses_;
+			return matrix_ptr();
+		}
+
+		++hits_;
+		// move to the front of the LRU list
+		entries_.splice( entries_.begin(), entries_, it->second );
+
+		return it->second->second;
+	}
+
+	//! \c insert, the lock must be held
+	void insert_locked(const key_type & key, const matrix_ptr & M)
+	{
+		const std::size_t bytes = size_in_bytes(*M);
+
+		if (bytes > capacity_)
+			return;
+
+		index_t::iterator it = index_.find(key);
+		if ( it != index_.end() )
+			erase(it);
+
+		entries_.push_front( std::make_pair(key, M) );
+		index_.insert( std::make_pair(key, entries_.begin()) );
+		size_ += bytes;
+
+		evict(capacity_);
+	}
+
+	//! remove an entry, the lock must be held
+	void erase(index_t::iterator it)
+	{
+		size_ -= size_in_bytes( *it->second->second );
+		entries_.erase(it->second);
+		index_.erase(it);
+	}
+
+	//! evict least recently used entries until at most \p bytes are held, the lock must be held
+	void evict(std::size_t bytes)
+	{
+		while (size_ > bytes)
+			erase( index_.find( entries_.back().first ) );
+	}
+
+	//! most recently used first
+	list_t entries_;
+	index_t index_;
+	pending_t pending_;
+
+	std::size_t capacity_;
+	std::size_t size_;
+	unsigned long long hits_;
+	unsigned long long misses_;
+
+	mutable std::mutex mutex_;
+};
+
+//! @}
+
+}	// namespace random
+
+}	// namespace qfcl
+
+#endif	// QFCL_RANDOM_JUMP_MATRIX_CACHE_HPP
@@ -17,12 +17,19 @@
 	\date March 23, 2012
 */
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/cstdint.hpp>
 #include <boost/lexical_cast.hpp>
@@ -38,6 +45,7 @@
 #include <qfcl/utility/io.hpp>
 
 #include "engine.hpp"
+#include "jump_matrix_cache.hpp"
 #include "matrix.hpp"
 
 #pragma warning(disable:4290)
@@ -57,6 +65,17 @@ namespace random {
 //! tag struct for linear generators engines
 struct linear_generator_engine_tag : public random_engine_tag {};
 
+//! algorithms for jumping ahead (or back) in a linear generator
+enum jump_algorithm
+{
+	//! applies \f$x^v \bmod p\f$ to the state, where \f$p\f$ is the minimal polynomial of the transition matrix
+	polynomial_jump,
+	//! multiplies the state by the jump matrix \f$A^v\f$, which is stored on disk
+	matrix_jump,
+	//! as \c matrix_jump, but the jump matrix file is memory mapped instead of read into memory
+	mapped_matrix_jump
+};
+
 namespace detail {
 
 template<typename charT, typename Traits, typename StateType>
@@ -107,6 +126,9 @@ private:
 public:
 	typedef Matrix<mod> matrix_t;
 	typedef Vector<mod> vector_t;
+	typedef Polynomial<mod> polynomial_t;
+	//! shared handle to a matrix held by the \c jump_matrix_cache
+	typedef jump_matrix_cache::matrix_ptr matrix_ptr;
 
 	struct state;
 
@@ -119,14 +141,22 @@ public:
 	result_type peek(unsigned long long v) const;
 
 	//! advance the state by \c num steps
-	void discard(unsigned long long num);
+	/*! The default \c polynomial_jump requires neither the jump matrix nor any file I/O.
+		The jump polynomial is composed from at most \c popcount(num) entries of 
+		\c JumpPolynomialTable(), so the cost is essentially independent of \p num.
+		It falls back to \c matrix_jump if the minimal polynomial could not be determined.
+	*/
+	void discard(unsigned long long num, jump_algorithm method = polynomial_jump);
 	
 	//! returns the transition matrix
 	static matrix_t & TransitionMatrix() {return TransitionMatrix_imp();}
 	//! whether the file containing the transition matrix exists
 	static bool TransitionMatrix_file_exists() {return TransitionMatrix_file_exists_imp();}
 	//! returns the jump matrix corresponding to the given \p jump_size
-	static matrix_t & JumpMatrix(unsigned long long jump_size)
+	/*! Jump matrices are kept in \c jump_matrix_cache::instance(), 
+		so several jump sizes can be used alternately without rereading the files.
+	*/
+	static matrix_ptr JumpMatrix(unsigned long long jump_size)
 	{
 		return JumpMatrix_imp(jump_size, false);
 	}
@@ -135,6 +165,29 @@ public:
 	{
 		return JumpMatrix_file_exists_imp(jump_size);
 	}
+	//! returns the memory mapped jump matrix file corresponding to the given \p jump_size
+	/*! The file is created if needed, and rewritten if it is in the original format.
+	*/
+	static std::shared_ptr<const mapped_matrix> MappedJumpMatrix(unsigned long long jump_size)
+	{
+		return MappedJumpMatrix_imp(jump_size, false);
+	}
+	//! returns the minimal polynomial of the transition matrix, or zero if it could not be determined
+	static const polynomial_t & MinimalPolynomial() {return MinimalPolynomial_imp();}
+	//! returns the polynomial \f$q\f$ of smallest degree with \f$q(A) = A^v\f$, where \f$v\f$ is the given \p jump_size
+	static polynomial_t JumpPolynomial(unsigned long long jump_size)
+	{
+		return JumpPolynomial_imp(jump_size, false);
+	}
+	//! returns the table of jump polynomials for jump sizes that are powers of 2
+	/*! The table is empty if the minimal polynomial could not be determined.
+	*/
+	static const jump_polynomial_table & JumpPolynomialTable() {return JumpPolynomialTable_imp();}
+	//! whether the jump polynomial table is read from (and saved to) disk, which is off by default
+	/*! This avoids recomputing the minimal polynomial in each process. 
+		It only has an effect if called before the first polynomial jump.
+	*/
+	static void PersistJumpPolynomialTable(bool persist) {persist_jump_polynomial_table() = persist;}
 
 	//! get the state of the engine
 	const state getState() const {return state(x, i);}
@@ -205,15 +258,6 @@ private:
 	//! index within the state of the next random number to be generated
 	std::size_t i;
 
-	//! the jump matrix
-	static matrix_t J;
-	//! whether the jump matrix has been set yet
-	static bool J_set;
-	//! size of the set jump matrix
-	static unsigned long long computed_size;
-	//! whether the set jump matrix corresponds to a reverse jump (only used for \c invertible_linear_generator s)
-	static bool computed_reverse;
-
 	//! re-seed the generator, \c seed() resets to the default seed
     void seed_imp(UIntType seed_ = EngineTraits::default_seed) {Derived::SeedInitialization(seed_, x, i);}
 	//! re-seed the generator with a sequence of seeds of arbitrary length
@@ -222,6 +266,9 @@ private:
 	//! common routine for seeding from a given state
 	void seed_imp(const state & s);
 
+	//! common routine for \c discard and \c reverse_discard
+	void jump_imp(unsigned long long num, bool reverse, jump_algorithm method);
+
 	//! The actual implementation of <tt>operator==</tt>. Requires <tt>i <= eng.i</tt>.
 	bool equal_imp(const linear_generator & eng) const;
 		
@@ -232,6 +279,29 @@ private:
 	//! i.e. begins with the number just generated; also non-static
 	template<typename OutIt>
 	void TransformedGet0(OutIt dest, size_t num, unsigned long long skip = 0) const;
+	//! transform the block <tt>x[first, last)</tt> into \c dest, and return the end of the output
+	/*! \c Derived may hide this with a specialized version.
+	*/
+	template<typename OutIt>
+	static OutIt Transform_n(const UIntType (&x)[n], size_t first, size_t last, OutIt dest)
+	{
+		// a tight loop over the block, which the compiler can vectorize when OutIt is a pointer
+		for (; first < last; ++first)
+			*(dest++) = Derived::Transform(x, first);
+
+		return dest;
+	}
+	//! transform the block <tt>x[first, last)</tt> into \c dest in reverse order, and return the end of the output
+	/*! \c Derived may hide this with a specialized version.
+	*/
+	template<typename OutIt>
+	static OutIt ReverseTransform_n(const UIntType (&x)[n], size_t first, size_t last, OutIt dest)
+	{
+		while (last > first)
+			*(dest++) = Derived::Transform(x, --last);
+
+		return dest;
+	}
 	
 	//! common routine for computing the transition matrix
 	static matrix_t & TransitionMatrix_imp(bool reverse = false);
@@ -239,14 +309,37 @@ private:
 	static bool TransitionMatrix_file_exists_imp(bool reverse = false);
 
 	//! common routine for computing the jump matrix
-	static matrix_t & JumpMatrix_imp(unsigned long long v, bool reverse);
+	static matrix_ptr JumpMatrix_imp(unsigned long long v, bool reverse);
 	//! common routine for checking whether the jump matrix exists
 	static bool JumpMatrix_file_exists_imp(unsigned long long jump_size, bool reverse = false);
+	//! common routine for mapping the jump matrix file
+	static std::shared_ptr<const mapped_matrix> MappedJumpMatrix_imp(unsigned long long jump_size, bool reverse);
+
+	//! common routine for computing the minimal polynomial
+	static const polynomial_t & MinimalPolynomial_imp();
+	//! common routine for computing the jump polynomial
+	static polynomial_t JumpPolynomial_imp(unsigned long long jump_size, bool reverse);
+	//! common routine for obtaining the jump polynomial table
+	static const jump_polynomial_table & JumpPolynomialTable_imp();
+	//! reads the jump polynomial table from disk if persistent and available, otherwise computes it
+	static jump_polynomial_table obtain_jump_polynomial_table();
+	//! computes the minimal polynomial, from the output of a default constructed engine
+	static polynomial_t obtain_minimal_polynomial();
+	//! whether the jump polynomial table is persistent
+	static bool & persist_jump_polynomial_table()
+	{
+		static bool persist = false;
+		return persist;
+	}
+	//! evaluates \p q at the transition matrix, using Horner's rule, and applies it to \p s
+	static state apply_polynomial(const polynomial_t & q, const state & s);
 
 	//! the name of the file containing the transition matrix
 	static std::string transition_matrix_filename(bool reverse = false);
 	//! the name of the file containing the jump matrix
 	static std::string jump_matrix_filename(unsigned long long jump_size, bool reverse = false);
+	//! the name of the file containing the jump polynomial table
+	static std::string jump_polynomial_table_filename();
 	//! handles \c linear_generator matrix reads, computing and storing on disk when needed
 	template<typename F>
     static matrix_t obtain_matrix(const std::string & filename, const F & f);
@@ -274,14 +367,25 @@ linear_generator<Derived, EngineType>::seed_imp(const state & s)
 // discard
 template<typename Derived, typename EngineType>
 inline void
-linear_generator<Derived, EngineType>::discard(unsigned long long num)
+linear_generator<Derived, EngineType>::discard(unsigned long long num, jump_algorithm method)
 {
-	matrix_t J = JumpMatrix(num);
+	jump_imp(num, false, method);
+}
 
+// jump_imp
+template<typename Derived, typename EngineType>
+inline void
+linear_generator<Derived, EngineType>::jump_imp(unsigned long long num, bool reverse, jump_algorithm method)
+{
 	state s = getState();
 
-	// advance num steps
-	s = J * s;
+	// move num steps
+	if ( method == polynomial_jump && !JumpPolynomialTable().empty() )
+		s = apply_polynomial( JumpPolynomial_imp(num, reverse), s );
+	else if (method == mapped_matrix_jump)
+		s = *MappedJumpMatrix_imp(num, reverse) * s;
+	else
+		s = *JumpMatrix_imp(num, reverse) * s;
 
 	// correct the initial r bits of the state
 	Derived::correct(s);
@@ -334,6 +438,14 @@ struct linear_generator<Derived, EngineTraits>::state
 	const UIntType * rep() const {return s;}
 	//! the number of \c UIntType elements comprising the state
 	static const size_t length() {return n;}
+	//! add the state \p t, i.e. bitwise xor
+	state & operator^=(const state & t)
+	{
+		for (size_t j = 0; j < n; ++j)
+			s[j] ^= t.s[j];
+
+		return *this;
+	}
 
 	//! conversion function from state to vector_t<mod>
 	// compiler has problem with out-of-class definition
@@ -385,21 +497,6 @@ linear_generator<Derived, EngineTraits>::state::state(const Vector<mod> & arr)
 			   make_bit_pseudoiterator<w>(s, r), true );
 }
 
-/* private static data */
-
-template<typename Derived, typename EngineTraits>
-typename linear_generator<Derived, EngineTraits>::matrix_t 
-linear_generator<Derived, EngineTraits>::J;
-
-template<typename Derived, typename EngineTraits>
-bool linear_generator<Derived, EngineTraits>::J_set = false;
-
-template<typename Derived, typename EngineTraits>
-unsigned long long linear_generator<Derived, EngineTraits>::computed_size;
-
-template<typename Derived, typename EngineTraits>
-bool linear_generator<Derived, EngineTraits>::computed_reverse;
-
 /* private static member functors */
 
 // Get
@@ -427,30 +524,17 @@ template<typename Derived, typename EngineType>
 inline typename linear_generator<Derived, EngineType>::matrix_t & 
 linear_generator<Derived, EngineType>::TransitionMatrix_imp(bool reverse)
 {
-	// transition matrix
-	static matrix_t A;
-	static bool A_set = false;
-
-	// reverse transition matrix
-	static matrix_t A_reverse;
-	static bool A_reverse_set = false;
-
-	if (!reverse && A_set)
-		return A;
-	else if (reverse && A_reverse_set)
-		return A_reverse;
-
+	// each is obtained on first use, once, even when first used by several threads at once
 	if (!reverse)
 	{
-     //   A = linear_generator<Derived, EngineType>::obtain_matrix( transition_matrix_filename(), transition_matrix_functor() );
-        A = obtain_matrix( transition_matrix_filename(), transition_matrix_functor() );
-		A_set = true;
+		// transition matrix
+		static matrix_t A = obtain_matrix( transition_matrix_filename(), transition_matrix_functor() );
 		return A;
 	}
 	else
 	{
-		A_reverse = obtain_matrix( transition_matrix_filename(reverse), transition_matrix_functor(reverse) );
-		A_reverse_set = true;
+		// reverse transition matrix
+		static matrix_t A_reverse = obtain_matrix( transition_matrix_filename(reverse), transition_matrix_functor(reverse) );
 		return A_reverse;
 	}
 }
@@ -467,32 +551,32 @@ linear_generator<Derived, EngineTraits>::TransitionMatrix_file_exists_imp(bool r
 
 // JumpMatrix_imp
 template<typename Derived, typename EngineTraits>
-inline typename linear_generator<Derived, EngineTraits>::matrix_t & 
+inline typename linear_generator<Derived, EngineTraits>::matrix_ptr
 linear_generator<Derived, EngineTraits>::JumpMatrix_imp(unsigned long long jump_size, bool reverse)
 {
+	static const std::string engine_name = boost::mpl::c_str<typename Derived::name>::value;
+
 	// -0 = 0
 	reverse = (reverse && jump_size > 0);
 
-	// check whether J currently holds the matrix for this jump, in both size and direction
-	if ( J_set && jump_size == computed_size && computed_reverse == reverse )
-		return J;
-
 	// filename of the jump matrix not reversed
-	std::string filename = jump_matrix_filename(jump_size);
-	
+	const std::string filename = jump_matrix_filename(jump_size);
+
+	// the file is only read (or the matrix computed) if the cache does not hold 
+	// the matrix for this jump, in both size and direction
+	jump_matrix_cache::key_type key(engine_name, jump_size, reverse);
+
 	if (reverse)
 	{
-		std::string reverse_filename = jump_matrix_filename(jump_size, reverse);
-		J = obtain_matrix( reverse_filename, reverse_jump_matrix_functor(jump_size, filename) );
+		const std::string reverse_filename = jump_matrix_filename(jump_size, reverse);
+		return jump_matrix_cache::instance().get( key, [&] () {
+			return obtain_matrix( reverse_filename, reverse_jump_matrix_functor(jump_size, filename) );
+		} );
 	}
 	else
-		J = obtain_matrix( filename, jump_matrix_functor(jump_size) );
-
-	J_set = true;
-	computed_size = jump_size;
-	computed_reverse = reverse;
-
-	return J;
+		return jump_matrix_cache::instance().get( key, [&] () {
+			return obtain_matrix( filename, jump_matrix_functor(jump_size) );
+		} );
 }
 
 // JumpMatrix_file_exists_imp
@@ -505,6 +589,160 @@ linear_generator<Derived, EngineTraits>::JumpMatrix_file_exists_imp(unsigned lon
 	return std::ifstream( filename.c_str() );
 }
 
+// MinimalPolynomial_imp
+template<typename Derived, typename EngineTraits>
+const typename linear_generator<Derived, EngineTraits>::polynomial_t &
+linear_generator<Derived, EngineTraits>::MinimalPolynomial_imp()
+{
+	static const polynomial_t p = obtain_minimal_polynomial();
+
+	return p;
+}
+
+// obtain_minimal_polynomial
+template<typename Derived, typename EngineTraits>
+typename linear_generator<Derived, EngineTraits>::polynomial_t
+linear_generator<Derived, EngineTraits>::obtain_minimal_polynomial()
+{
+	// Each output bit is a linear recurring sequence, whose minimal polynomial divides 
+	// the minimal polynomial of the transition matrix. If their least common multiple 
+	// has degree k, then it is the minimal (and characteristic) polynomial.
+	std::vector<vector_t> sequences(w);
+	for (size_t b = 0; b < w; ++b)
+		sequences[b].SetLength(2 * k);
+
+	Derived eng;
+	for (size_t t = 0; t < 2 * k; ++t)
+	{
+		UIntType y = eng();
+		for (size_t b = 0; b < w; ++b)
+			sequences[b][t] = (y >> b) & 1;
+	}
+
+	polynomial_t p = minimal_polynomial(sequences, k);
+
+	// otherwise it is only the minimal polynomial for this particular state
+	if ( NTL::deg(p) != static_cast<long>(k) )
+		NTL::clear(p);
+
+	return p;
+}
+
+// JumpPolynomial_imp
+template<typename Derived, typename EngineTraits>
+inline typename linear_generator<Derived, EngineTraits>::polynomial_t
+linear_generator<Derived, EngineTraits>::JumpPolynomial_imp(unsigned long long jump_size, bool reverse)
+{
+	const jump_polynomial_table & table = JumpPolynomialTable();
+
+	if ( table.empty() )
+		throw std::logic_error("the minimal polynomial of the linear generator could not be determined");
+
+	return table.power(jump_size, reverse);
+}
+
+// JumpPolynomialTable_imp
+template<typename Derived, typename EngineTraits>
+inline const jump_polynomial_table &
+linear_generator<Derived, EngineTraits>::JumpPolynomialTable_imp()
+{
+	static const jump_polynomial_table table = obtain_jump_polynomial_table();
+
+	return table;
+}
+
+// obtain_jump_polynomial_table
+template<typename Derived, typename EngineTraits>
+jump_polynomial_table
+linear_generator<Derived, EngineTraits>::obtain_jump_polynomial_table()
+{
+	static const std::string engine_name = boost::mpl::c_str<typename Derived::name>::value;
+	const std::string filename = jump_polynomial_table_filename();
+	const bool persist = persist_jump_polynomial_table();
+
+	jump_polynomial_table table;
+
+	if (persist)
+	{
+		try
+		{
+			if ( table.read(filename) && NTL::deg( table.modulus() ) == static_cast<long>(k) )
+				return table;
+		}
+		catch (const std::runtime_error & e)
+		{
+			// recompute, and replace the file
+			std::cerr << "Exception thrown: " << e.what() << std::endl;
+		}
+	}
+
+	table = jump_polynomial_table( MinimalPolynomial() );
+
+	if ( persist && !table.empty() )
+		table.write(filename, engine_name);
+
+	return table;
+}
+
+// apply_polynomial
+template<typename Derived, typename EngineTraits>
+typename linear_generator<Derived, EngineTraits>::state
+linear_generator<Derived, EngineTraits>::apply_polynomial(const polynomial_t & q, const state & s)
+{
+	const UIntType zero[n] = {};
+	state result(zero);
+
+	// only the upper w - r bits of s[0] are used by the transition, 
+	// so the lower r bits of result are left to be corrected
+	for (long j = NTL::deg(q); j >= 0; --j)
+	{
+		result = Derived::Transition(result);
+		if ( NTL::IsOne( NTL::coeff(q, j) ) )
+			result ^= s;
+	}
+
+	return result;
+}
+
+// MappedJumpMatrix_imp
+template<typename Derived, typename EngineTraits>
+std::shared_ptr<const mapped_matrix>
+linear_generator<Derived, EngineTraits>::MappedJumpMatrix_imp(unsigned long long jump_size, bool reverse)
+{
+	typedef std::map< std::pair<unsigned long long, bool>, std::shared_ptr<const mapped_matrix> > map_t;
+	static map_t mapped;
+	static std::mutex mapped_mutex;
+	static const std::string engine_name = boost::mpl::c_str<typename Derived::name>::value;
+
+	// -0 = 0
+	reverse = (reverse && jump_size > 0);
+
+	// the lock is also held while the file is created, so it is only created once
+	std::lock_guard<std::mutex> lock(mapped_mutex);
+
+	const typename map_t::key_type key(jump_size, reverse);
+	typename map_t::const_iterator it = mapped.find(key);
+	if ( it != mapped.end() )
+		return it->second;
+
+	const std::string filename = jump_matrix_filename(jump_size, reverse);
+
+	if ( !mapped_matrix::is_mappable(filename) )
+	{
+		// creates the file if it does not exist
+		matrix_ptr J = JumpMatrix_imp(jump_size, reverse);
+
+		// an existing file in the original format
+		if ( !mapped_matrix::is_mappable(filename) )
+			J -> write(filename, engine_name);
+	}
+
+	std::shared_ptr<const mapped_matrix> M = std::make_shared<const mapped_matrix>(filename);
+	mapped[key] = M;
+
+	return M;
+}
+
 // obtain_matrix
 template<typename Derived, typename EngineTraits>
 template<typename F>
@@ -520,7 +758,7 @@ linear_generator<Derived, EngineTraits>::obtain_matrix(const std::string & filen
 		if (!exists)
 		{
 			A = f();
-			A.write(filename);
+			A.write( filename, boost::mpl::c_str<typename Derived::name>::value );
 		}
 	}
 	catch(std::exception e)
@@ -545,20 +783,26 @@ struct linear_generator<Derived, EngineTraits>::transition_matrix_functor
 
 		// compute A
 		A.SetDims(k, k);
-		for (size_t i = 0; i < k; ++i)
+		// The columns are independent, and each thread assigns to its own rows of A^T.
+		// Only vec_GF2 is used here: its allocation is plain malloc, and the rows of A already have
+		// length k, so assigning to one copies words without touching the others. NTL's shared 
+		// scratch space (such as the GF2X arithmetic, which is not thread safe) is never reached.
+		detail::parallel_blocks( 0, static_cast<long>(k), 64, [&A, this](long first, long last)
 		{
-			vector_t x;
-			x.SetLength(k);
-			x[i] = 1;
+			for (long i = first; i < last; ++i)
+			{
+				vector_t x;
+				x.SetLength(k);
+				x[i] = 1;
 
-	
-			// i-th column of A
+				// i-th column of A
 
-			// work with A^T instead
-			// note that, as a concept feature, we need a corrected state when going in reverse
-			A[i] = !reverse ? Derived::Transition(x) 
-				: Derived::ReverseTransition( invertible_linear_generator<Derived, EngineTraits>::correct(x) );
-		}
+				// work with A^T instead
+				// note that, as a concept feature, we need a corrected state when going in reverse
+				A[i] = !reverse ? Derived::Transition(x) 
+					: Derived::ReverseTransition( invertible_linear_generator<Derived, EngineTraits>::correct(x) );
+			}
+		} );
 
 		return transpose(A);
 	}
@@ -639,6 +883,17 @@ linear_generator<Derived, EngineTraits>::jump_matrix_filename(unsigned long long
 	return filename;
 }
 
+// jump_polynomial_table_filename
+template<typename Derived, typename EngineTraits>
+std::string 
+linear_generator<Derived, EngineTraits>::jump_polynomial_table_filename()
+{
+	static const std::string type_id = "JumpPolynomialTable";
+    static const std::string engine_name = boost::mpl::c_str<typename Derived::name>::value;
+
+	return engine_name + '.' + type_id;
+}
+
 // equal_imp
 template<typename Derived, typename EngineTraits>
 bool 
@@ -720,8 +975,45 @@ public:
         Derived::Next(this -> x, this -> i);
         return z;
     }
+
+	//! generate \p num random numbers into \p dest, and return the end of the output
+	/*! Equivalent to \p num calls of <tt>operator()</tt>, but the state is advanced 
+		a block of \c n words at a time by \c Derived::Next_n.
+	*/
+	template<typename OutIt>
+	OutIt generate(OutIt dest, size_t num);
+	//! fill <tt>[first, last)</tt> with random numbers, \sa generate
+	template<typename FwdIt>
+	void fill(FwdIt first, FwdIt last) {generate( first, std::distance(first, last) );}
 };
 
+// generate
+template<typename Derived, typename EngineTraits>
+template<typename OutIt>
+OutIt
+noninvertible_linear_generator<Derived, EngineTraits>::generate(OutIt dest, size_t num)
+{
+	static const size_t n = base_type::n;
+
+	while (num > 0)
+	{
+		// the rest of the current block
+		// (n is not passed to std::min, as it has no out-of-class definition)
+		const size_t last = num < n - this -> i ? this -> i + num : n;
+		dest = Derived::Transform_n(this -> x, this -> i, last, dest);
+		num -= last - this -> i;
+
+		this -> i = last;
+		if (this -> i == n)
+		{
+			Derived::Next_n(this -> x);
+			this -> i = 0;
+		}
+	}
+
+	return dest;
+}
+
 /** invertible_linear_generator class template */
 
 template<typename Derived, typename EngineTraits>
@@ -737,6 +1029,7 @@ public:
     QFCL_USING_TYPE(UIntType, base_type);
     QFCL_USING_TYPE(state, base_type);
     QFCL_USING_TYPE(matrix_t, base_type);
+    QFCL_USING_TYPE(matrix_ptr, base_type);
     using base_type::default_seed;
     using base_type::n;
 
@@ -760,6 +1053,25 @@ public:
         return Derived::Transform(this -> x, this -> i);
     }
 
+	//! generate \p num random numbers into \p dest, and return the end of the output
+	/*! Equivalent to \p num calls of <tt>operator()</tt>, but the state is advanced 
+		a block of \c n words at a time by \c Derived::Next_n, and each block is 
+		transformed in a single loop.
+	*/
+	template<typename OutIt>
+	OutIt generate(OutIt dest, size_t num);
+	//! fill <tt>[first, last)</tt> with random numbers, \sa generate
+	template<typename FwdIt>
+	void fill(FwdIt first, FwdIt last) {generate( first, std::distance(first, last) );}
+
+	//! generate \p num random numbers in reverse into \p dest, and return the end of the output
+	/*! Equivalent to \p num calls of \c reverse(), but the state is reverted a block of
+		\c n words at a time by \c Derived::Previous_n, and each block is transformed in a 
+		single loop.
+	*/
+	template<typename OutIt>
+	OutIt reverse_generate(OutIt dest, size_t num);
+
 	/*! \brief generate a random number in reverse
 	
 		Returns the previously generated random number, 
@@ -777,7 +1089,9 @@ public:
 	static state correct(const state & s);
 	
 	//! revert the state by \c num steps
-	void reverse_discard(unsigned long long num);
+	/*! \sa linear_generator::discard
+	*/
+	void reverse_discard(unsigned long long num, jump_algorithm method = polynomial_jump);
 	//! skip \c num step, where \c num can be negative
 	void skip(long long num);
 	
@@ -797,11 +1111,11 @@ public:
 	}
 
 	//! JumpMatrices for negative jumps too
-	static matrix_t & JumpMatrix(unsigned long long jump_size, bool reverse = false)
+	static matrix_ptr JumpMatrix(unsigned long long jump_size, bool reverse = false)
 	{
         return base_type::JumpMatrix_imp(jump_size, reverse);
 	}
-	static matrix_t & JumpMatrix(long long jump_size) {return JumpMatrix( ::abs(jump_size), jump_size < 0 );}
+	static matrix_ptr JumpMatrix(long long jump_size) {return JumpMatrix( ::abs(jump_size), jump_size < 0 );}
 	
 	//! whether the file containing the jump matrix of jump size v exists
 	static bool JumpMatrix_file_exists(unsigned long long jump_size, bool reverse = false)
@@ -809,12 +1123,75 @@ public:
         return base_type::JumpMatrix_file_exists_imp(jump_size, reverse);
 	}
 	static bool JumpMatrix_file_exists(long long jump_size) {return JumpMatrix_file_exists( ::abs(jump_size), jump_size < 0 );}
+	//! memory mapped JumpMatrices for negative jumps too
+	static std::shared_ptr<const mapped_matrix> MappedJumpMatrix(unsigned long long jump_size, bool reverse = false)
+	{
+        return base_type::MappedJumpMatrix_imp(jump_size, reverse);
+	}
+
+	//! JumpPolynomials for negative jumps too
+	static typename base_type::polynomial_t JumpPolynomial(unsigned long long jump_size, bool reverse = false)
+	{
+		return base_type::JumpPolynomial_imp(jump_size, reverse);
+	}
 private:
 	//! reverse version of TransformedGet0
 	template<typename OutIt>
 	void ReverseTransformedGet0(OutIt dest, size_t num, unsigned long long skip = 0) const;
 };
 
+// generate
+template<typename Derived, typename EngineTraits>
+template<typename OutIt>
+OutIt
+invertible_linear_generator<Derived, EngineTraits>::generate(OutIt dest, size_t num)
+{
+	while (num > 0)
+	{
+		// x[i] is the number just generated
+		size_t first = this -> i + 1;
+		if (first == n)
+		{
+			Derived::Next_n(this -> x);
+			first = 0;
+		}
+
+		const size_t last = num < n - first ? first + num : n;
+		dest = Derived::Transform_n(this -> x, first, last, dest);
+		num -= last - first;
+
+		this -> i = last - 1;
+	}
+
+	return dest;
+}
+
+// reverse_generate
+template<typename Derived, typename EngineTraits>
+template<typename OutIt>
+OutIt
+invertible_linear_generator<Derived, EngineTraits>::reverse_generate(OutIt dest, size_t num)
+{
+	while (num > 0)
+	{
+		// x[i], x[i - 1], ..., x[0] are the next numbers generated in reverse
+		const size_t count = num < this -> i + 1 ? num : this -> i + 1;
+		const size_t first = this -> i + 1 - count;
+		dest = Derived::ReverseTransform_n(this -> x, first, this -> i + 1, dest);
+		num -= count;
+
+		if (first == 0)
+		{
+			Derived::Previous_n(this -> x);
+			this -> i = n - 1;
+		}
+		else
+			this -> i = first - 1;
+	}
+
+	return dest;
+}
+
 // seed
 /*! Only the last \c w bits of each seed are used.
 */
@@ -901,21 +1278,10 @@ invertible_linear_generator<Derived, EngineType>::correct(const state & s)
 // reverse_discard
 template<typename Derived, typename EngineType>
 inline void
-invertible_linear_generator<Derived, EngineType>::reverse_discard(unsigned long long num)
+invertible_linear_generator<Derived, EngineType>::reverse_discard(unsigned long long num, jump_algorithm method)
 {
-	matrix_t J = JumpMatrix(num, true);
-
-	/// NOTE: FACTOR OUT COMMON CODE. FIX THIS
-    state s = this -> getState();
-
-	// advance num steps
-	s = J * s;
-
-	// correct the initial r bits of the state
-	Derived::correct(s);
-
-	// upcast to seed
-	static_cast<Derived *>(this) -> seed(s);
+	// -0 = 0
+	this -> jump_imp( num, num > 0, method );
 }
 
 // skip
@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 
 #include "matrix.hpp"
@@ -12,34 +18,98 @@ NTL::mat_GF2 identity<NTL::mat_GF2>(const NTL::mat_GF2 & M)
 	return NTL::ident_mat_GF2( M.NumRows() );
 }
 
+namespace {
+
+const char matrix_file_magic[8] = "QFCLMAT";
+
+//! number of words in a row of the file, including padding to a 64 byte boundary
+boost::uint64_t row_stride(boost::uint64_t row_words)
+{
+	static const boost::uint64_t words_per_line = 64 / sizeof(_ntl_ulong);
+
+	return (row_words + words_per_line - 1) / words_per_line * words_per_line;
+}
+
+//! word-wise FNV-1a hash, used as the file checksum
+boost::uint64_t checksum(boost::uint64_t h, const _ntl_ulong * p, boost::uint64_t n)
+{
+	for (boost::uint64_t i = 0; i < n; ++i)
+		h = (h ^ p[i]) * 1099511628211ull;
+
+	return h;
+}
+
+const boost::uint64_t checksum_seed = 14695981039346656037ull;
+
+//! reads the header and checks that it is usable on this platform
+bool valid_header(const detail::matrix_file_header & header)
+{
+	return std::equal( header.magic, header.magic + sizeof(header.magic), matrix_file_magic )
+		&& header.version == Matrix<2>::file_version
+		&& header.word_size == sizeof(_ntl_ulong)
+		&& header.rows <= static_cast<boost::uint64_t>(NTL_MAX_LONG)
+		&& header.cols <= static_cast<boost::uint64_t>(NTL_MAX_LONG)
+		&& header.row_words == (header.cols + NTL_BITS_PER_LONG - 1) / NTL_BITS_PER_LONG
+		&& header.row_stride >= header.row_words
+		&& header.engine_name[sizeof(header.engine_name) - 1] == '\0';
+}
+
+}	// namespace
+
 // write
-void Matrix<2>::write(const std::string & filename) const throw(std::runtime_error)
+void Matrix<2>::write(const std::string & filename, const std::string & engine_name) const throw(std::runtime_error)
 {
 	using namespace std;
 
-	ofstream ofs( filename.c_str(), ios::binary );
+	if ( engine_name.size() >= sizeof(detail::matrix_file_header().engine_name) )
+		throw std::runtime_error("Error in Matrix<2>::write: engine name is too long.");
+
+	detail::matrix_file_header header = {};
+	copy( matrix_file_magic, matrix_file_magic + sizeof(matrix_file_magic), header.magic );
+	header.version = file_version;
+	header.word_size = sizeof(_ntl_ulong);
+	header.rows = NumRows();
+	header.cols = NumCols();
+	header.row_words = NumRows() > 0 ? (*this)[0].rep.length() : 0;
+	header.row_stride = row_stride(header.row_words);
+	copy( engine_name.begin(), engine_name.end(), header.engine_name );
+
+	header.checksum = checksum_seed;
+	for (long i = 0; i < NumRows(); ++i)
+		header.checksum = checksum( header.checksum, (*this)[i].rep.rep, header.row_words );
+
+	// write to a temporary file first, so that readers never see a partial file
+	boost::filesystem::path tmp_file = boost::filesystem::unique_path( filename + ".%%%%-%%%%-%%%%.tmp" );
 
-	if (ofs)
 	{
-		// sizeof element must be 1
-		ostreambuf_iterator<char> iter( ofs.rdbuf() );
+		ofstream ofs( tmp_file.string().c_str(), ios::binary );
 
-		// write the shape first
-		long rows = NumRows();
-		long cols = NumCols();
-		qfcl::io::write_char_n( &rows, sizeof(rows), iter );
-		qfcl::io::write_char_n( &cols, sizeof(cols), iter );
-	
-		for (long i = 0; i < rows; ++i)
+		if (!ofs)
+			throw std::runtime_error("Error in Matrix<2>::write: Unable to open file for writing.");
+
+		ofs.write( reinterpret_cast<const char *>(&header), sizeof(header) );
+
+		const vector<_ntl_ulong> padding(header.row_stride - header.row_words);
+		for (long i = 0; i < NumRows(); ++i)
 		{
-			qfcl::io::write_char_n( (*this)[i].rep.rep, (*this)[i].rep.length() * sizeof(_ntl_ulong), iter );
+			ofs.write( reinterpret_cast<const char *>((*this)[i].rep.rep), header.row_words * sizeof(_ntl_ulong) );
+			if ( !padding.empty() )
+				ofs.write( reinterpret_cast<const char *>(&padding[0]), padding.size() * sizeof(_ntl_ulong) );
 		}
 
-		ofs.close();
+		if (!ofs)
+			throw std::runtime_error("Error in Matrix<2>::write: Unable to write to file.");
 	}
-	else
+
+	try
 	{
-		throw std::runtime_error("Error in matrix_GF2<T>::write: Unable to open file for writing.");
+		boost::filesystem::rename(tmp_file, filename);
+	}
+	catch (const boost::filesystem::filesystem_error & e)
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove(tmp_file, ec);
+		throw std::runtime_error( std::string("Error in Matrix<2>::write: ") + e.what() );
 	}
 }
 
@@ -55,34 +125,142 @@ bool Matrix<2>::read(const std::string & filename) throw(std::runtime_error)
 
 	ifstream ifs( filename.c_str(), ios::binary );
 
-	//auto state = ifs.rdstate();
+	if (!ifs)
+		throw std::runtime_error("Error in Matrix<2>::read: Unable to open file for reading.");
+
+	detail::matrix_file_header header;
+	ifs.read( reinterpret_cast<char *>(&header), sizeof(header) );
 
-	if (ifs)
+	if ( ifs && std::equal( header.magic, header.magic + sizeof(header.magic), matrix_file_magic ) )
 	{
-		// sizeof element must be 1
-		istreambuf_iterator<char> iter( ifs.rdbuf() );
+		if ( !valid_header(header) )
+			throw std::runtime_error("Error in Matrix<2>::read: Unsupported matrix file version or word size.");
+
+		// before allocating, as for mapped_matrix
+		const boost::uint64_t data_words = (boost::filesystem::file_size(matrix_file) - sizeof(header)) / sizeof(_ntl_ulong);
+		if ( header.row_stride > 0 && header.rows > data_words / header.row_stride )
+			throw std::runtime_error("Error in Matrix<2>::read: Matrix file is truncated.");
+
+		SetDims( static_cast<long>(header.rows), static_cast<long>(header.cols) );
+		if ( header.rows > 0 && static_cast<boost::uint64_t>((*this)[0].rep.length()) != header.row_words )
+			throw std::runtime_error("Error in Matrix<2>::read: Inconsistent row length.");
+
+		const streamoff padding = (header.row_stride - header.row_words) * sizeof(_ntl_ulong);
+		boost::uint64_t sum = checksum_seed;
+		for (long i = 0; i < NumRows(); ++i)
+		{
+			ifs.read( reinterpret_cast<char *>((*this)[i].rep.rep), header.row_words * sizeof(_ntl_ulong) );
+			ifs.seekg(padding, ios::cur);
+			sum = checksum( sum, (*this)[i].rep.rep, header.row_words );
+		}
+
+		if (!ifs)
+			throw std::runtime_error("Error in Matrix<2>::read: Matrix file is truncated.");
+		if (sum != header.checksum)
+			throw std::runtime_error("Error in Matrix<2>::read: Checksum mismatch.");
+	}
+	else
+	{
+		// the original format: the shape followed by the unpadded rows
+		ifs.clear();
+		ifs.seekg(0);
 
-		// read the shape first
 		long rows;
 		long cols;
-		qfcl::io::read_char_n( &rows, sizeof(rows), iter );
-		qfcl::io::read_char_n( &cols, sizeof(cols), iter );
+		ifs.read( reinterpret_cast<char *>(&rows), sizeof(rows) );
+		ifs.read( reinterpret_cast<char *>(&cols), sizeof(cols) );
 
 		SetDims(rows, cols);
 	
 		for (long i = 0; i < rows; ++i)
-		{
-			qfcl::io::read_char_n( (*this)[i].rep.rep, (*this)[i].rep.length() * sizeof(_ntl_ulong), iter );
-		}
+			ifs.read( reinterpret_cast<char *>((*this)[i].rep.rep), (*this)[i].rep.length() * sizeof(_ntl_ulong) );
 
-		ifs.close();
+		if (!ifs)
+			throw std::runtime_error("Error in Matrix<2>::read: Matrix file is truncated.");
 	}
-	else
+
+	return true;
+}
+
+// ctor
+mapped_matrix::mapped_matrix(const std::string & filename, bool verify) throw(std::runtime_error)
+{
+	using namespace boost::interprocess;
+
+	try
 	{
-		throw std::runtime_error("Error in matrix_GF2<T>::read: Unable to open file for reading.");
+		file_mapping(filename.c_str(), read_only).swap(file);
+		mapped_region(file, read_only).swap(region);
+	}
+	catch (const interprocess_exception & e)
+	{
+		throw std::runtime_error( std::string("Error in mapped_matrix: Unable to map file: ") + e.what() );
 	}
 
-	return true;
+	if ( region.get_size() < sizeof(detail::matrix_file_header) )
+		throw std::runtime_error("Error in mapped_matrix: Not a matrix file.");
+
+	header = static_cast<const detail::matrix_file_header *>( region.get_address() );
+
+	if ( !valid_header(*header) )
+		throw std::runtime_error("Error in mapped_matrix: Unsupported matrix file version or word size.");
+
+	// rows * row_stride could overflow for a corrupt header, so compare by division
+	const boost::uint64_t data_words = (region.get_size() - sizeof(*header)) / sizeof(word_type);
+	if ( header->row_stride > 0 && header->rows > data_words / header->row_stride )
+		throw std::runtime_error("Error in mapped_matrix: Matrix file is truncated.");
+
+	data = reinterpret_cast<const word_type *>(header + 1);
+
+	if (verify)
+	{
+		boost::uint64_t sum = checksum_seed;
+		for (long i = 0; i < NumRows(); ++i)
+			sum = checksum( sum, row(i), header->row_words );
+
+		if (sum != header->checksum)
+			throw std::runtime_error("Error in mapped_matrix: Checksum mismatch.");
+	}
+}
+
+// is_mappable
+bool mapped_matrix::is_mappable(const std::string & filename)
+{
+	std::ifstream ifs( filename.c_str(), std::ios::binary );
+
+	detail::matrix_file_header header;
+	ifs.read( reinterpret_cast<char *>(&header), sizeof(header) );
+
+	return ifs && valid_header(header);
+}
+
+// operator*
+Vector<2> mapped_matrix::operator*(const Vector<2> & v) const
+{
+	if ( v.length() != NumCols() )
+		throw std::invalid_argument("mapped_matrix: dimension mismatch in matrix-vector product");
+
+	Vector<2> result;
+	result.SetLength( NumRows() );
+
+	const word_type * x = v.rep.rep;
+	const boost::uint64_t row_words = header->row_words;
+
+	for (long i = 0; i < NumRows(); ++i)
+	{
+		const word_type * a = row(i);
+		word_type acc = 0;
+		for (boost::uint64_t j = 0; j < row_words; ++j)
+			acc ^= a[j] & x[j];
+
+		// parity of acc
+		for (size_t shift = sizeof(acc) * 4; shift > 0; shift >>= 1)
+			acc ^= acc >> shift;
+
+		result.put(i, static_cast<long>(acc & 1));
+	}
+
+	return result;
 }
 
 template<>
@@ -91,6 +269,444 @@ Matrix<2> identity< Matrix<2> >(const Matrix<2> & M)
 	return NTL::ident_mat_GF2( M.NumRows() );
 }
 
+namespace {
+
+//! number of rows of B combined in each Four Russians table
+const long m4rm_bits = 8;
+//! number of words in a block of columns, one cache line
+const long m4rm_block_words = 64 / sizeof(_ntl_ulong);
+//! number of rows of C in a block, so that a block of C stays in L2 cache
+const long m4rm_block_rows = 2048;
+//! smallest number of rows of C given to a thread
+const long mul_min_thread_rows = 256;
+
+//! the number of threads used by Matrix<2>::mul, 0 for the default
+std::atomic<unsigned> mul_threads(0);
+
+/*! \brief M4RM for the rows <tt>[row_begin, row_end)</tt> of \p C
+
+	\p C is divided into tiles of \c m4rm_block_rows rows by \c m4rm_block_words words, 
+	which are accumulated in a contiguous buffer. For each tile, and each group of 8 rows 
+	of \p B, the sums of all subsets of the group are tabulated (restricted to the columns
+	of the tile). Each row of the tile is then updated by the table entry indexed by the 
+	corresponding 8 bits of \p A. The bytes of \p A are transposed beforehand, so that 
+	they are read sequentially.
+*/
+void mul_m4rm(NTL::mat_GF2 & C, const NTL::mat_GF2 & A, const NTL::mat_GF2 & B, long row_begin, long row_end)
+{
+	const long rows = row_end - row_begin;
+	const long l = A.NumCols();
+	const long groups = (l + m4rm_bits - 1) / m4rm_bits;
+	const long words = C.NumRows() > 0 ? C[0].rep.length() : 0;
+
+	if (rows <= 0 || words == 0)
+		return;
+
+	// A_bytes[g * rows + i] holds columns [8g, 8g + 8) of row row_begin + i of A
+	// (a group is never split across words, since the word size is a multiple of 8)
+	std::vector<unsigned char> A_bytes(groups * rows);
+	for (long i = 0; i < rows; ++i)
+	{
+		const _ntl_ulong * a = A[row_begin + i].rep.rep;
+		for (long g = 0; g < groups; ++g)
+		{
+			const long bit = g * m4rm_bits;
+			A_bytes[g * rows + i] = static_cast<unsigned char>( a[bit / NTL_BITS_PER_LONG] >> (bit % NTL_BITS_PER_LONG) );
+		}
+	}
+
+	// the table of subset sums, and the tile of C
+	std::vector<_ntl_ulong> table( (1 << m4rm_bits) * m4rm_block_words );
+	std::vector<_ntl_ulong> tile( m4rm_block_rows * m4rm_block_words );
+
+	for (long c0 = 0; c0 < words; c0 += m4rm_block_words)
+	{
+		const long bw = std::min(m4rm_block_words, words - c0);
+
+		for (long i0 = 0; i0 < rows; i0 += m4rm_block_rows)
+		{
+			const long nr = std::min(m4rm_block_rows, rows - i0);
+
+			std::fill( tile.begin(), tile.end(), 0 );
+
+			for (long g = 0; g < groups; ++g)
+			{
+				const long row0 = g * m4rm_bits;
+				const long group = std::min(m4rm_bits, l - row0);
+
+				// table[t] is the sum of the rows row0 + b of B for the bits b set in t
+				// (bits beyond the last column of A are always 0)
+				std::fill( table.begin(), table.begin() + m4rm_block_words, 0 );
+				for (long b = 0; b < group; ++b)
+				{
+					const _ntl_ulong * B_row = B[row0 + b].rep.rep + c0;
+					const long half = 1l << b;
+
+					for (long t = 0; t < half; ++t)
+					{
+						const _ntl_ulong * src = &table[t * m4rm_block_words];
+						_ntl_ulong * dest = &table[(t + half) * m4rm_block_words];
+						for (long j = 0; j < bw; ++j)
+							dest[j] = src[j] ^ B_row[j];
+					}
+				}
+
+				// fixed length rows, so that the compiler can vectorize the xor
+				const unsigned char * index = &A_bytes[g * rows + i0];
+				for (long i = 0; i < nr; ++i)
+				{
+					const _ntl_ulong * src = &table[index[i] * m4rm_block_words];
+					_ntl_ulong * dest = &tile[i * m4rm_block_words];
+					for (long j = 0; j < m4rm_block_words; ++j)
+						dest[j] ^= src[j];
+				}
+			}
+
+			for (long i = 0; i < nr; ++i)
+				std::copy( &tile[i * m4rm_block_words], &tile[i * m4rm_block_words] + bw, C[row_begin + i0 + i].rep.rep + c0 );
+		}
+	}
+}
+
+/*! \brief \f$C = AB\f$ for the rows <tt>[row_begin, row_end)</tt> of \p C, by adding the rows of \p B
+	selected by the nonzero entries of \p A
+
+	This is faster than M4RM when \p A is sparse, such as the early powers of a transition matrix.
+*/
+void mul_sparse(NTL::mat_GF2 & C, const NTL::mat_GF2 & A, const NTL::mat_GF2 & B, long row_begin, long row_end)
+{
+	const long a_words = A.NumRows() > 0 ? A[0].rep.length() : 0;
+	const long words = C.NumRows() > 0 ? C[0].rep.length() : 0;
+
+	for (long i = row_begin; i < row_end; ++i)
+	{
+		const _ntl_ulong * a = A[i].rep.rep;
+		_ntl_ulong * dest = C[i].rep.rep;
+
+		for (long k = 0; k < a_words; ++k)
+		{
+			_ntl_ulong w = a[k];
+			for (long b = k * NTL_BITS_PER_LONG; w != 0; w >>= 1, ++b)
+			{
+				if (w & 1)
+				{
+					const _ntl_ulong * src = B[b].rep.rep;
+					for (long j = 0; j < words; ++j)
+						dest[j] ^= src[j];
+				}
+			}
+		}
+	}
+}
+
+//! whether the rows <tt>[row_begin, row_end)</tt> of \p A have fewer nonzero entries than M4RM table lookups
+bool is_sparse(const NTL::mat_GF2 & A, long row_begin, long row_end)
+{
+	const long a_words = A.NumRows() > 0 ? A[0].rep.length() : 0;
+	const long lookups = (row_end - row_begin) * ( (A.NumCols() + m4rm_bits - 1) / m4rm_bits );
+
+	long nonzero = 0;
+	for (long i = row_begin; i < row_end; ++i)
+	{
+		const _ntl_ulong * a = A[i].rep.rep;
+		for (long k = 0; k < a_words; ++k)
+			for (_ntl_ulong w = a[k]; w != 0; w &= w - 1)
+				if (++nonzero >= lookups)
+					return false;
+	}
+
+	return true;
+}
+
+}	// namespace
+
+// mul
+void Matrix<2>::mul(NTL::mat_GF2 & C, const NTL::mat_GF2 & A, const NTL::mat_GF2 & B)
+{
+	if ( A.NumCols() != B.NumRows() )
+		throw std::invalid_argument("Matrix<2>::mul: dimension mismatch");
+
+	// the product is formed in a new matrix, since C may alias A or B
+	NTL::mat_GF2 product;
+	product.SetDims( A.NumRows(), B.NumCols() );
+
+	// each thread writes to its own rows of product, which are already allocated
+	detail::parallel_blocks( 0, A.NumRows(), mul_min_thread_rows, 
+		[&product, &A, &B](long row_begin, long row_end)
+		{
+			if ( is_sparse(A, row_begin, row_end) )
+				mul_sparse(product, A, B, row_begin, row_end);
+			else
+				mul_m4rm(product, A, B, row_begin, row_end);
+		} );
+
+	NTL::swap(C, product);
+}
+
+// threads
+unsigned Matrix<2>::threads()
+{
+	const unsigned n = mul_threads;
+	if (n > 0)
+		return n;
+
+	const unsigned hardware = std::thread::hardware_concurrency();
+	return hardware > 0 ? hardware : 1;
+}
+
+void Matrix<2>::threads(unsigned n)
+{
+	mul_threads = n;
+}
+
+// matrix_pool
+std::shared_ptr<work_stealing_pool> detail::matrix_pool()
+{
+	static std::mutex mutex;
+	static std::shared_ptr<work_stealing_pool> pool;
+
+	const unsigned threads = Matrix<2>::threads();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if ( !pool || pool->size() != threads )
+		pool = std::make_shared<work_stealing_pool>(threads);
+
+	return pool;
+}
+
+// minimal_polynomial
+Polynomial<2> minimal_polynomial(const std::vector< Vector<2> > & sequences, long degree_bound)
+{
+	Polynomial<2> p;
+	NTL::set(p);
+
+	for (auto seq = sequences.begin(); seq != sequences.end() && NTL::deg(p) < degree_bound; ++seq)
+	{
+		NTL::GF2X h;
+		NTL::MinPolySeq(h, *seq, degree_bound);
+
+		// lcm(p, h) = p * h / gcd(p, h)
+		p = (p / NTL::GCD(p, h)) * h;
+	}
+
+	return p;
+}
+
+// ctor
+jump_polynomial_table::jump_polynomial_table(const Polynomial<2> & _p)
+{
+	set_modulus(_p);
+}
+
+// set_modulus
+void jump_polynomial_table::set_modulus(const Polynomial<2> & _p)
+{
+	p = _p;
+	forward.clear();
+	reverse.clear();
+
+	if ( NTL::IsZero(p) )
+		return;
+
+	NTL::build(F, p);
+
+	// x mod p
+	NTL::GF2X x;
+	NTL::rem( x, NTL::GF2X(1, 1), p );
+
+	forward.resize(size);
+	forward[0] = x;
+	for (size_t j = 1; j < size; ++j)
+		forward[j] = NTL::SqrMod(forward[j - 1], F);
+
+	if ( NTL::IsZero( NTL::ConstTerm(p) ) )
+		return;
+
+	reverse.resize(size);
+	NTL::InvMod(reverse[0], x, p);
+	for (size_t j = 1; j < size; ++j)
+		reverse[j] = NTL::SqrMod(reverse[j - 1], F);
+}
+
+// power
+Polynomial<2> jump_polynomial_table::power(unsigned long long e, bool reverse) const throw(std::logic_error)
+{
+	const std::vector< Polynomial<2> > & table = reverse ? this -> reverse : forward;
+
+	if ( table.empty() )
+		throw std::logic_error("jump_polynomial_table: the table has not been computed");
+
+	NTL::GF2X result;
+	NTL::set(result);
+
+	// binary decomposition of e
+	for (size_t j = 0; e != 0; ++j, e >>= 1)
+		if (e & 1)
+			NTL::MulMod(result, result, table[j], F);
+
+	return result;
+}
+
+namespace {
+
+const char polynomial_table_file_magic[8] = "QFCLPOL";
+
+/*! \brief header of the binary jump polynomial table file format
+
+	The header is followed by \c count polynomials: the modulus, the forward table 
+	and the reverse table. Each polynomial is its byte count as a 32-bit integer 
+	followed by the polynomial in NTL byte format (least significant coefficients first).
+*/
+struct polynomial_table_file_header
+{
+	char magic[8];
+	boost::uint32_t version;
+	//! number of polynomials: 1, 1 + size or 1 + 2 * size
+	boost::uint32_t count;
+	//! checksum of everything following the header
+	boost::uint64_t checksum;
+	//! name of the engine the table belongs to, null terminated (may be empty)
+	char engine_name[104];
+};
+
+static_assert( sizeof(polynomial_table_file_header) == 128, "unexpected padding in polynomial_table_file_header" );
+
+//! byte-wise FNV-1a hash, used as the file checksum
+boost::uint64_t byte_checksum(const std::vector<char> & bytes)
+{
+	boost::uint64_t h = checksum_seed;
+	for (size_t i = 0; i < bytes.size(); ++i)
+		h = (h ^ static_cast<unsigned char>(bytes[i])) * 1099511628211ull;
+
+	return h;
+}
+
+//! appends the byte count and bytes of \p a to \p buffer
+void append_polynomial(std::vector<char> & buffer, const NTL::GF2X & a)
+{
+	const boost::uint32_t n = static_cast<boost::uint32_t>( NTL::NumBytes(a) );
+	const char * n_bytes = reinterpret_cast<const char *>(&n);
+	buffer.insert( buffer.end(), n_bytes, n_bytes + sizeof(n) );
+
+	const size_t offset = buffer.size();
+	buffer.resize(offset + n);
+	if (n > 0)
+		NTL::BytesFromGF2X( reinterpret_cast<unsigned char *>(&buffer[offset]), a, n );
+}
+
+//! reads a polynomial written by \c append_polynomial from \p is
+bool read_polynomial(std::istream & is, std::vector<char> & buffer, NTL::GF2X & a)
+{
+	boost::uint32_t n;
+	if ( !is.read( reinterpret_cast<char *>(&n), sizeof(n) ) )
+		return false;
+
+	const size_t offset = buffer.size();
+	const char * n_bytes = reinterpret_cast<const char *>(&n);
+	buffer.insert( buffer.end(), n_bytes, n_bytes + sizeof(n) );
+	buffer.resize(offset + sizeof(n) + n);
+	if ( n > 0 && !is.read( &buffer[offset + sizeof(n)], n ) )
+		return false;
+
+	NTL::clear(a);
+	if (n > 0)
+		NTL::GF2XFromBytes( a, reinterpret_cast<const unsigned char *>(&buffer[offset + sizeof(n)]), n );
+
+	return true;
+}
+
+}	// namespace
+
+// write
+void jump_polynomial_table::write(const std::string & filename, const std::string & engine_name) const throw(std::runtime_error)
+{
+	using namespace std;
+
+	polynomial_table_file_header header = {};
+
+	if ( engine_name.size() >= sizeof(header.engine_name) )
+		throw std::runtime_error("Error in jump_polynomial_table::write: engine name is too long.");
+
+	vector<char> buffer;
+	append_polynomial(buffer, p);
+	for (size_t j = 0; j < forward.size(); ++j)
+		append_polynomial(buffer, forward[j]);
+	for (size_t j = 0; j < reverse.size(); ++j)
+		append_polynomial(buffer, reverse[j]);
+
+	copy( polynomial_table_file_magic, polynomial_table_file_magic + sizeof(polynomial_table_file_magic), header.magic );
+	header.version = file_version;
+	header.count = static_cast<boost::uint32_t>( 1 + forward.size() + reverse.size() );
+	header.checksum = byte_checksum(buffer);
+	copy( engine_name.begin(), engine_name.end(), header.engine_name );
+
+	// write to a temporary file first, so that readers never see a partial file
+	boost::filesystem::path tmp_file = boost::filesystem::unique_path( filename + ".%%%%-%%%%-%%%%.tmp" );
+
+	{
+		ofstream ofs( tmp_file.string().c_str(), ios::binary );
+
+		if (!ofs)
+			throw std::runtime_error("Error in jump_polynomial_table::write: Unable to open file for writing.");
+
+		ofs.write( reinterpret_cast<const char *>(&header), sizeof(header) );
+		ofs.write( &buffer[0], buffer.size() );
+
+		if (!ofs)
+			throw std::runtime_error("Error in jump_polynomial_table::write: Unable to write to file.");
+	}
+
+	try
+	{
+		boost::filesystem::rename(tmp_file, filename);
+	}
+	catch (const boost::filesystem::filesystem_error & e)
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove(tmp_file, ec);
+		throw std::runtime_error( std::string("Error in jump_polynomial_table::write: ") + e.what() );
+	}
+}
+
+// read, return value indicates whether the file exists
+bool jump_polynomial_table::read(const std::string & filename) throw(std::runtime_error)
+{
+	using namespace std;
+
+	if ( !boost::filesystem::exists( boost::filesystem::path(filename) ) )
+		return false;
+
+	ifstream ifs( filename.c_str(), ios::binary );
+
+	if (!ifs)
+		throw std::runtime_error("Error in jump_polynomial_table::read: Unable to open file for reading.");
+
+	polynomial_table_file_header header;
+	ifs.read( reinterpret_cast<char *>(&header), sizeof(header) );
+
+	if ( !ifs || !std::equal( header.magic, header.magic + sizeof(header.magic), polynomial_table_file_magic ) 
+		|| header.version != file_version
+		|| (header.count != 1 && header.count != 1 + size && header.count != 1 + 2 * size) )
+		throw std::runtime_error("Error in jump_polynomial_table::read: Not a supported jump polynomial table file.");
+
+	vector<char> buffer;
+	vector< Polynomial<2> > polynomials(header.count);
+	for (size_t j = 0; j < polynomials.size(); ++j)
+		if ( !read_polynomial(ifs, buffer, polynomials[j]) )
+			throw std::runtime_error("Error in jump_polynomial_table::read: File is truncated.");
+
+	if ( byte_checksum(buffer) != header.checksum )
+		throw std::runtime_error("Error in jump_polynomial_table::read: Checksum mismatch.");
+
+	p = polynomials[0];
+	if ( !NTL::IsZero(p) )
+		NTL::build(F, p);
+	forward.assign( polynomials.begin() + 1, polynomials.begin() + std::min<size_t>(header.count, 1 + size) );
+	reverse.assign( polynomials.begin() + std::min<size_t>(header.count, 1 + size), polynomials.end() );
+
+	return true;
+}
+
 }	// namespace random
 
 }	// namespace qfcl
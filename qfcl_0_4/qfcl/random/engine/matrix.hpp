@@ -11,7 +11,7 @@
 #define	QFCL_RANDOM_MATRIX_HPP
 
 /*! \file qfcl/random/engine/matrix.hpp
-	\brief Vectors and matrices for linear generators
+	\brief Vectors, matrices and polynomials for linear generators
 
 	\author James Hirschorn
 	\date June 11, 2012
@@ -19,13 +19,22 @@
 
 #pragma warning(disable:4290)
 
+#include <cstddef>
 #include <fstream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <NTL/GF2X.h>
 #include <NTL/mat_GF2.h>
 
 #include <qfcl/utility/io.hpp>
+#include <qfcl/utility/work_stealing_pool.hpp>
 
 namespace qfcl {
 
@@ -74,13 +83,40 @@ T pow(const T & M, unsigned long long e)
 	return result;
 }
 
+/*! \brief header of the binary matrix file format
+
+	The header is followed by the rows, each padded with zeros to \c row_stride words
+	so that every row begins on a 64 byte boundary (the header itself is 128 bytes). 
+	The checksum is taken over the unpadded rows.
+*/
+struct matrix_file_header
+{
+	//! "QFCLMAT" followed by a null character
+	char magic[8];
+	//! format version, see \c Matrix<2>::file_version
+	boost::uint32_t version;
+	//! number of bytes per word of row data
+	boost::uint32_t word_size;
+	boost::uint64_t rows;
+	boost::uint64_t cols;
+	//! number of words of data per row
+	boost::uint64_t row_words;
+	//! number of words from the start of one row to the next
+	boost::uint64_t row_stride;
+	boost::uint64_t checksum;
+	//! name of the engine the matrix belongs to, null terminated (may be empty)
+	char engine_name[72];
+};
+
+static_assert( sizeof(matrix_file_header) == 128, "unexpected padding in matrix_file_header" );
+
 }	// namespace detail
 
 /*! \ingroup random
 	@{
 */
 	
-/* the vector and matrix types for a modulus m generator */
+/* the vector, matrix and polynomial types for a modulus m generator */
 
 template<size_t m>
 class Vector
@@ -92,6 +128,11 @@ class Matrix
 {
 };
 
+template<size_t m>
+class Polynomial
+{
+};
+
 template<>
 class Vector<2> : public NTL::vec_GF2
 {
@@ -114,15 +155,194 @@ public:
 	//! implicit conversion from base type
 	Matrix(const NTL::mat_GF2 & M) : NTL::mat_GF2(M) {}
 
-	//! write the matix to the file \c filename
-    void write(const std::string & filename) const throw(std::runtime_error);
+	//! matrix product using the Method of Four Russians, see \c Matrix<2>::mul
+	Matrix & operator*=(const Matrix & B) {mul(*this, *this, B); return *this;}
+
+	/*! \brief \f$C = AB\f$ using the Method of Four Russians (M4RM)
+
+		The rows of \p B are taken 8 at a time, and all 256 of their sums are tabulated
+		so that each row of \p C is updated with a single lookup per 8 columns of \p A.
+		The columns of \p C are processed in blocks of one cache line, so that the 
+		table stays in L1 cache. Requires \f$O(n^3 / \log n)\f$ word operations,
+		compared with \f$O(n^3)\f$ for \c NTL::mul. If \p A has fewer nonzero entries than
+		table lookups, the rows of \p B are simply added instead. \p C may alias \p A or \p B.
+
+		The rows of \p C are divided into blocks which are computed on \c threads() threads.
+	*/
+	static void mul(NTL::mat_GF2 & C, const NTL::mat_GF2 & A, const NTL::mat_GF2 & B);
+
+	//! the number of threads used by \c mul, by default the number of hardware threads
+	static unsigned threads();
+	//! set the number of threads used by \c mul, 0 restores the default
+	static void threads(unsigned n);
+
+	//! the current version of the file format, see \c detail::matrix_file_header
+	static const boost::uint32_t file_version = 1;
+
+	//! write the matix to the file \c filename, optionally recording the name of its engine
+	/*! The file is written under a temporary name and then renamed, so that other processes 
+		never see a partially written file.
+	*/
+    void write(const std::string & filename, const std::string & engine_name = std::string()) const throw(std::runtime_error);
 	//! read the matrix from the file \c filename, and indicate if it exists
+	/*! Files written in the original (unversioned) format are also accepted.
+	*/
 	bool read(const std::string & filename) throw(std::runtime_error);
 };
 
+/*! \brief A read-only matrix memory mapped from a file written by \c Matrix<2>::write
+
+	The rows are used directly from the mapping without being copied, and the pages
+	are shared by all processes mapping the same file.
+*/
+class mapped_matrix
+{
+public:
+	typedef _ntl_ulong word_type;
+
+	//! maps the file \p filename, verifying the checksum if \p verify is \c true
+	/*! Throws \c std::runtime_error if the file is not in the current format.
+	*/
+	explicit mapped_matrix(const std::string & filename, bool verify = false) throw(std::runtime_error);
+
+	//! whether \p filename exists and is in the current format, so that it can be mapped
+	static bool is_mappable(const std::string & filename);
+
+	long NumRows() const {return static_cast<long>(header->rows);}
+	long NumCols() const {return static_cast<long>(header->cols);}
+	//! the words of the i-th row
+	const word_type * row(long i) const {return data + i * header->row_stride;}
+	//! the name of the engine recorded in the file
+	std::string engine_name() const {return header->engine_name;}
+
+	//! matrix-vector product
+	Vector<2> operator*(const Vector<2> & v) const;
+private:
+	// not copyable
+	mapped_matrix(const mapped_matrix &);
+	mapped_matrix & operator=(const mapped_matrix &);
+
+	boost::interprocess::file_mapping file;
+	boost::interprocess::mapped_region region;
+	const detail::matrix_file_header * header;
+	const word_type * data;
+};
+
 template<>
 Matrix<2> identity< Matrix<2> >(const Matrix<2> & M);
 
+namespace detail {
+
+//! the pool running \c parallel_blocks, with \c Matrix<2>::threads() workers
+/*! A new pool is made when the number of threads has changed; the callers still using the old one keep it alive.
+*/
+std::shared_ptr<work_stealing_pool> matrix_pool();
+
+/*! \brief calls <tt>f(first, last)</tt> on blocks partitioning <tt>[begin, end)</tt>, concurrently on up to \c Matrix<2>::threads() threads
+
+	Blocks have at least \p min_block elements. They are run on the workers of \c matrix_pool(), 
+	which are started once rather than on every call, and one of which is the calling thread.
+	Calls from several threads share the pool and are run one after the other, so \p f must not 
+	itself call \c parallel_blocks. If \p f throws, the blocks not yet started are skipped and the 
+	exception is rethrown once the running ones have finished.
+*/
+template<typename F>
+void parallel_blocks(long begin, long end, long min_block, const F & f)
+{
+	const long n = end - begin;
+	long blocks = static_cast<long>( Matrix<2>::threads() );
+	if (min_block > 0 && n / min_block < blocks)
+		blocks = n / min_block;
+
+	if (blocks <= 1)
+	{
+		f(begin, end);
+		return;
+	}
+
+	const std::shared_ptr<work_stealing_pool> pool = matrix_pool();
+	pool->parallel_for( static_cast<std::size_t>(blocks), [&f, begin, n, blocks](std::size_t b)
+	{
+		const long i = static_cast<long>(b);
+		f(begin + n * i / blocks, begin + n * (i + 1) / blocks);
+	} );
+}
+
+}	// namespace detail
+
+//! matrix product using the Method of Four Russians, see \c Matrix<2>::mul
+inline Matrix<2> operator*(const Matrix<2> & A, const Matrix<2> & B)
+{
+	Matrix<2> C;
+	Matrix<2>::mul(C, A, B);
+
+	return C;
+}
+
+template<>
+class Polynomial<2> : public NTL::GF2X
+{
+public:
+	//! default constructor, the zero polynomial
+	Polynomial() : NTL::GF2X() {}
+	//! implicit conversion from base type
+	Polynomial(const NTL::GF2X & p) : NTL::GF2X(p) {}
+};
+
+/*! \brief the minimal polynomial of a linear recurrence, determined from sequences it generates
+
+	Returns the least common multiple of the minimal polynomials of \p sequences, 
+	each computed with the Berlekamp-Massey algorithm. Every sequence must have 
+	length at least <tt>2 * degree_bound</tt>, where \p degree_bound bounds the degree
+	of the recurrence. Stops early once the degree reaches \p degree_bound.
+*/
+Polynomial<2> minimal_polynomial(const std::vector< Vector<2> > & sequences, long degree_bound);
+
+/*! \brief table of \f$x^{2^j} \bmod p\f$ and \f$x^{-2^j} \bmod p\f$ for \f$j = 0,\dots,63\f$
+
+	Any jump polynomial \f$x^{\pm e} \bmod p\f$ is then a product of at most 
+	\f$\mathrm{popcount}(e)\f$ table entries, so its cost does not depend on the size of \f$e\f$.
+*/
+class jump_polynomial_table
+{
+public:
+	//! the number of powers of 2 in the table
+	static const size_t size = 64;
+	//! the current version of the file format
+	static const boost::uint32_t file_version = 1;
+
+	//! the empty table
+	jump_polynomial_table() {}
+	//! computes the table for the modulus \p p
+	/*! The reverse table is only computed if \f$x\f$ is invertible modulo \p p, i.e. 
+		\p p has nonzero constant term.
+	*/
+	explicit jump_polynomial_table(const Polynomial<2> & p);
+
+	//! whether the table has not been computed
+	bool empty() const {return NTL::IsZero(p);}
+	//! the modulus
+	const Polynomial<2> & modulus() const {return p;}
+
+	//! returns \f$x^e \bmod p\f$, or \f$x^{-e} \bmod p\f$ if \p reverse is \c true
+	Polynomial<2> power(unsigned long long e, bool reverse = false) const throw(std::logic_error);
+
+	//! write the table to the file \c filename, optionally recording the name of its engine
+	void write(const std::string & filename, const std::string & engine_name = std::string()) const throw(std::runtime_error);
+	//! read the table from the file \c filename, and indicate if it exists
+	bool read(const std::string & filename) throw(std::runtime_error);
+private:
+	//! computes the \c GF2XModulus and the table
+	void set_modulus(const Polynomial<2> & _p);
+
+	Polynomial<2> p;
+	NTL::GF2XModulus F;
+	//! \f$x^{2^j} \bmod p\f$
+	std::vector< Polynomial<2> > forward;
+	//! \f$x^{-2^j} \bmod p\f$, empty if \f$x\f$ is not invertible
+	std::vector< Polynomial<2> > reverse;
+};
+
 //! @}
 
 }	// namespace random
@@ -28,11 +28,14 @@
 
 #include <boost/cstdint.hpp>
 #include <boost/integer/integer_mask.hpp>
+#include <boost/mpl/if.hpp>
 #include <boost/mpl/string.hpp>
+#include <boost/type_traits/is_same.hpp>
 //! alias
 namespace mpl = boost::mpl;
 
 #include <qfcl/types.hpp>
+#include <qfcl/utility/simd.hpp>
 #include <qfcl/utility/tmp.hpp>
 
 #include "linear_generator.hpp"
@@ -246,13 +249,212 @@ struct mersenne_twister_policy_traits_temper
 	}
 };
 
+/*! \brief the twist and the tempering applied to whole blocks of the state
+
+	\p Ops are the SIMD operations from \c simd::vector_ops, or \c void for scalar code.
+	\p Policy is the complete policy traits class, providing the single value \c twist and \c temper.
+*/
+template<typename EngineTraits, typename Ops, typename Policy>
+struct mersenne_twister_policy_traits_block
+{
+	typedef typename EngineTraits::UIntType UIntType;
+
+	//! number of values processed at once
+	static const size_t lanes = 1;
+
+	//! <tt>xk[j] = twist(xk[j], xkp1[j], xkpm[j])</tt> for <tt>j < count</tt>, in increasing order of \c j
+	static void twist_lanes(UIntType * xk, const UIntType * xkp1, const UIntType * xkpm, size_t count)
+	{
+		for (size_t j = 0; j < count; ++j)
+			xk[j] = Policy::twist(xk[j], xkp1[j], xkpm[j]);
+	}
+
+	//! <tt>xk[j] = twist(xk[j], xk[j + 1], xkpm[j])</tt> for <tt>j < count</tt>, in increasing order of \c j
+	static void twist_block(UIntType * xk, const UIntType * xkpm, size_t count)
+	{
+		twist_lanes(xk, xk + 1, xkpm, count);
+	}
+
+	/*! \brief inverts the \f$\oplus\f$ in (2.1) and the multiplication by A, 
+		giving \f$\mathbf{x}^u_k | \mathbf{x}^l_{k+1}\f$ from \f$\mathbf{x}_{k+n}\f$ and \f$\mathbf{x}_{k+m}\f$
+	
+		This requires that the high-bit of \c a is 1.
+	*/
+	static UIntType untwist(UIntType xkpn, UIntType xkpm)
+	{
+		const UIntType y = xkpn ^ xkpm;
+		// the low-bit of x_{k+1} (or of x_k for TGFSR)
+		const UIntType low_bit = ( y >> (EngineTraits::word_size - 1) ) & 1;
+
+		return ( (y ^ (low_bit * EngineTraits::xor_mask)) << 1 ) | low_bit;
+	}
+
+	//! <tt>y[j] = untwist(xkpn[j], xkpm[j])</tt> for <tt>j < count</tt>
+	static void untwist_lanes(UIntType * y, const UIntType * xkpn, const UIntType * xkpm, size_t count)
+	{
+		for (size_t j = 0; j < count; ++j)
+			y[j] = untwist(xkpn[j], xkpm[j]);
+	}
+
+	//! <tt>x[j] = (yk[j] & umask) | (ykm1[j] & lmask)</tt> for <tt>j < count</tt>
+	static void join_lanes(UIntType * x, const UIntType * yk, const UIntType * ykm1, size_t count)
+	{
+		for (size_t j = 0; j < count; ++j)
+			x[j] = (yk[j] & EngineTraits::umask) | (ykm1[j] & EngineTraits::lmask);
+	}
+
+	//! tempers <tt>src[0, count)</tt> into \p dest, and returns the end of the output
+	template<typename OutIt>
+	static OutIt temper_block(const UIntType * src, size_t count, OutIt dest)
+	{
+		for (size_t j = 0; j < count; ++j)
+			*(dest++) = Policy::temper(src[j]);
+
+		return dest;
+	}
+};
+
+/*! \brief SIMD version, with \c lanes values in each vector register
+
+	Produces exactly the same output as the scalar version. \c twist_lanes requires that
+	\p xkp1 does not point into <tt>(xk - lanes, xk)</tt> and \p xkpm does not point into 
+	<tt>(xk - lanes, xk + lanes)</tt>, so that each vector reads values that are either not 
+	yet overwritten or already final.
+*/
+template<typename EngineTraits, typename Ops, typename Policy>
+struct mersenne_twister_policy_traits_block_simd
+{
+	typedef typename EngineTraits::UIntType UIntType;
+	typedef typename Ops::vector vector;
+	typedef mersenne_twister_policy_traits_block<EngineTraits, void, Policy> scalar;
+
+	static const size_t lanes = Ops::lanes;
+
+	static void twist_lanes(UIntType * xk, const UIntType * xkp1, const UIntType * xkpm, size_t count)
+	{
+		const vector umask = Ops::set1(EngineTraits::umask), lmask = Ops::set1(EngineTraits::lmask);
+		const vector a = Ops::set1(EngineTraits::xor_mask);
+
+		size_t j = 0;
+		for (; j + lanes <= count; j += lanes)
+		{
+			const vector v0 = Ops::load(xk + j), v1 = Ops::load(xkp1 + j), vm = Ops::load(xkpm + j);
+			vector y, mag;
+
+			// see mersenne_twister_policy_traits_twist
+			if (EngineTraits::mask_bits == 0)
+			{
+				y = Ops::template srli<1>(v0);
+				mag = Ops::and_( Ops::low_bit_mask(v0), a );
+			}
+			else
+			{
+				y = Ops::template srli<1>( Ops::or_( Ops::and_(v0, umask), Ops::and_(v1, lmask) ) );
+				mag = Ops::and_( Ops::low_bit_mask(v1), a );
+			}
+
+			Ops::store( xk + j, Ops::xor_( vm, Ops::xor_(y, mag) ) );
+		}
+
+		// fewer than lanes are left, which also bounds the loop for the compiler
+		for (size_t k = 0; k < count % lanes; ++k, ++j)
+			xk[j] = Policy::twist(xk[j], xkp1[j], xkpm[j]);
+	}
+
+	static void twist_block(UIntType * xk, const UIntType * xkpm, size_t count)
+	{
+		twist_lanes(xk, xk + 1, xkpm, count);
+	}
+
+	static UIntType untwist(UIntType xkpn, UIntType xkpm) {return scalar::untwist(xkpn, xkpm);}
+
+	static void untwist_lanes(UIntType * y, const UIntType * xkpn, const UIntType * xkpm, size_t count)
+	{
+		static const int high_bit = static_cast<int>(EngineTraits::word_size) - 1;
+		const vector a = Ops::set1(EngineTraits::xor_mask), one = Ops::set1(1);
+
+		size_t j = 0;
+		for (; j + lanes <= count; j += lanes)
+		{
+			const vector v = Ops::xor_( Ops::load(xkpn + j), Ops::load(xkpm + j) );
+			// all bits set where the high-bit of v is 1
+			const vector mask = Ops::low_bit_mask( Ops::template srli<high_bit>(v) );
+
+			Ops::store( y + j, Ops::or_( Ops::template slli<1>( Ops::xor_( v, Ops::and_(mask, a) ) ), Ops::and_(mask, one) ) );
+		}
+
+		for (size_t k = 0; k < count % lanes; ++k, ++j)
+			y[j] = untwist(xkpn[j], xkpm[j]);
+	}
+
+	static void join_lanes(UIntType * x, const UIntType * yk, const UIntType * ykm1, size_t count)
+	{
+		const vector umask = Ops::set1(EngineTraits::umask), lmask = Ops::set1(EngineTraits::lmask);
+
+		size_t j = 0;
+		for (; j + lanes <= count; j += lanes)
+			Ops::store( x + j, Ops::or_( Ops::and_( Ops::load(yk + j), umask ), Ops::and_( Ops::load(ykm1 + j), lmask ) ) );
+
+		for (size_t k = 0; k < count % lanes; ++k, ++j)
+			x[j] = (yk[j] & EngineTraits::umask) | (ykm1[j] & EngineTraits::lmask);
+	}
+
+	template<typename OutIt>
+	static OutIt temper_block(const UIntType * src, size_t count, OutIt dest)
+	{
+		return scalar::temper_block(src, count, dest);
+	}
+
+	//! vectorized when writing to an array
+	static UIntType * temper_block(const UIntType * src, size_t count, UIntType * dest)
+	{
+		static const int u = static_cast<int>(EngineTraits::tempering_u), s = static_cast<int>(EngineTraits::tempering_s);
+		static const int t = static_cast<int>(EngineTraits::tempering_t), l = static_cast<int>(EngineTraits::tempering_l);
+		const vector d = Ops::set1(EngineTraits::tempering_d), b = Ops::set1(EngineTraits::tempering_b), 
+			c = Ops::set1(EngineTraits::tempering_c);
+
+		size_t j = 0;
+		for (; j + lanes <= count; j += lanes)
+		{
+			vector y = Ops::load(src + j);
+
+			// see mersenne_twister_policy_traits_temper
+			if (EngineTraits::tempering_u < EngineTraits::word_size)
+				y = Ops::xor_( y, Ops::and_( Ops::template srli<u>(y), d ) );
+			y = Ops::xor_( y, Ops::and_( Ops::template slli<s>(y), b ) );
+			y = Ops::xor_( y, Ops::and_( Ops::template slli<t>(y), c ) );
+			if (EngineTraits::tempering_l < EngineTraits::word_size)
+				y = Ops::xor_( y, Ops::template srli<l>(y) );
+
+			Ops::store(dest + j, y);
+		}
+
+		for (size_t k = 0; k < count % lanes; ++k, ++j)
+			dest[j] = Policy::temper(src[j]);
+
+		return dest + count;
+	}
+};
+
+//! the SIMD block operations are used whenever \c simd::vector_ops supports \c UIntType
+template<typename EngineTraits, typename Policy>
+struct mersenne_twister_policy_traits_block_selector
+{
+	typedef typename simd::vector_ops<typename EngineTraits::UIntType>::type Ops;
+
+	typedef typename mpl::if_< boost::is_same<Ops, void>,
+		mersenne_twister_policy_traits_block<EngineTraits, void, Policy>,
+		mersenne_twister_policy_traits_block_simd<EngineTraits, Ops, Policy> >::type type;
+};
+
 template<typename EngineTraits>
 struct mersenne_twister_policy_traits
 	: public mersenne_twister_policy_traits_twist< EngineTraits, 
 		mpl::equal_to< mpl::long_<EngineTraits::mask_bits>, mpl::long_<0> >::value >,
 	  public mersenne_twister_policy_traits_temper< EngineTraits,
 		mpl::less< mpl::long_<EngineTraits::tempering_u>, mpl::long_<EngineTraits::word_size> >::value,
-		mpl::less< mpl::long_<EngineTraits::tempering_l>, mpl::long_<EngineTraits::word_size> >::value >
+		mpl::less< mpl::long_<EngineTraits::tempering_l>, mpl::long_<EngineTraits::word_size> >::value >,
+	  public mersenne_twister_policy_traits_block_selector< EngineTraits, mersenne_twister_policy_traits<EngineTraits> >::type
 {
 };
 
@@ -347,6 +549,29 @@ private:
 	static void Previous(UIntType (&x)[n], size_t & i);
 	//! apply the output transformation
 	static result_type Transform(const UIntType (&x)[n], size_t i);
+	//! apply the output transformation to the block <tt>x[first, last)</tt>, \sa linear_generator::Transform_n
+	template<typename OutIt>
+	static OutIt Transform_n(const UIntType (&x)[n], size_t first, size_t last, OutIt dest)
+	{
+		return PolicyTraits::temper_block(x + first, last - first, dest);
+	}
+	//! apply the output transformation to the block <tt>x[first, last)</tt> in reverse order, \sa linear_generator::ReverseTransform_n
+	template<typename OutIt>
+	static OutIt ReverseTransform_n(const UIntType (&x)[n], size_t first, size_t last, OutIt dest)
+	{
+		while (last > first)
+			*(dest++) = Transform(x, --last);
+
+		return dest;
+	}
+	//! when writing to an array, the block is tempered in order and then reversed in place
+	static result_type * ReverseTransform_n(const UIntType (&x)[n], size_t first, size_t last, result_type * dest)
+	{
+		result_type * end = PolicyTraits::temper_block(x + first, last - first, dest);
+		std::reverse(dest, end);
+
+		return end;
+	}
 
 	//! get the first word of the next state
 	static UIntType GetNext(const UIntType (&x)[n], size_t i);
@@ -379,17 +604,7 @@ private:
 	*/
 	static UIntType reverse_twist_invert(UIntType xkpn, UIntType xkpm)
 	{
-		UIntType y = xkpn ^ xkpm;
-
-		// multiply on the right by the inverse of A
-		// this requires that the high-bit of a is 1
-		if ( y & ( UIntType(1) << (w - 1) ) ) // parenthesis around w-1 prevents MS warning C4554
-			// low-bit of x_{k+1} is 1
-			y = ( (y ^ xor_mask) << 1 ) | 1;
-		else 
-			y = y << 1;
-
-		return y;
+		return PolicyTraits::untwist(xkpn, xkpm);
 	}
 
 	// the following methods are only needed to implement
@@ -470,14 +685,14 @@ template<typename EngineTraits>
 template<typename It>
 mersenne_twister_engine<EngineTraits>::mersenne_twister_engine(It begin, It end)
 {
-	seed(begin, end);
+	this -> seed(begin, end);
 }
 
 // ctor
 template<typename EngineTraits>
 mersenne_twister_engine<EngineTraits>::mersenne_twister_engine(const state & s)
 {
-	seed(s);
+	this -> seed(s);
 }
 
 template<typename EngineTraits>
@@ -718,12 +933,22 @@ mersenne_twister_engine<EngineTraits>::Next_n(UIntType (&x)[n])
 	*/
 
 	static const size_t m = shift_size;
+	static const size_t lanes = PolicyTraits::lanes;
 
-	for (size_t k = 0; k < n - m; ++k)
-		x[k] = PolicyTraits::twist(x[k], x[k + 1], x[k + m]);
+	if (m >= lanes && n - m >= lanes)
+	{
+		// in blocks of lanes values (see mersenne_twister_policy_traits_block_simd)
+		PolicyTraits::twist_block(x, x + m, n - m);
+		PolicyTraits::twist_block(x + (n - m), x, m - 1);
+	}
+	else
+	{
+		for (size_t k = 0; k < n - m; ++k)
+			x[k] = PolicyTraits::twist(x[k], x[k + 1], x[k + m]);
 
-	for (size_t k = n - m; k < n - 1; ++k)
-		x[k] = PolicyTraits::twist(x[k], x[k + 1], x[k - (n - m)]);
+		for (size_t k = n - m; k < n - 1; ++k)
+			x[k] = PolicyTraits::twist(x[k], x[k + 1], x[k - (n - m)]);
+	}
 
 	x[n - 1] = PolicyTraits::twist(x[n - 1], x[0], x[m - 1]);
 }
@@ -735,6 +960,45 @@ mersenne_twister_engine<EngineTraits>::Previous_n(UIntType (&x)[n])
 {
 	using std::size_t;
 
+	static const size_t m = shift_size;
+	static const size_t lanes = PolicyTraits::lanes;
+
+	if (m > lanes && n - m >= lanes)
+	{
+		/*	in blocks of lanes values (see mersenne_twister_policy_traits_block_simd)
+
+			Let x_k be the old and x_{k + n} the new state. Then y_k = untwist(x_{k + n}, x_{k + m}) 
+			is the upper bits of x_k and the lower bits of x_{k + 1}, for -1 <= k < n.
+		*/
+		UIntType y_buffer[n + 1];
+		UIntType * y = y_buffer + 1;
+
+		// x_{k + m} is new for k >= n - m
+		PolicyTraits::untwist_lanes(y + (n - m), x + (n - m), x, m);
+
+		// otherwise x_{k + m} is recovered from y_{k + m} and y_{k + m - 1}, which are already known
+		// since we work downwards and m > lanes
+		UIntType xkpm[lanes];
+		for (size_t j = n - m; j > 0; )
+		{
+			const size_t count = j < lanes ? j : lanes;
+			j -= count;
+
+			PolicyTraits::join_lanes(xkpm, y + j + m, y + j + m - 1, count);
+			PolicyTraits::untwist_lanes(y + j, x + j, xkpm, count);
+		}
+
+		// x_{n - 1} = twist(x_{-1}, x_0, x_{m - 1})
+		UIntType xnm1, xmm1;
+		PolicyTraits::join_lanes(&xnm1, y + (n - 1), y + (n - 2), 1);
+		PolicyTraits::join_lanes(&xmm1, y + (m - 1), y + (m - 2), 1);
+		y[-1] = PolicyTraits::untwist(xnm1, xmm1);
+
+		PolicyTraits::join_lanes(x, y, y - 1, n);
+
+		return;
+	}
+
 	ssize_t sm = shift_size, sn = n;
 
 	/*  perform n-step twist
@@ -19,6 +19,8 @@
 	\date February 29, 2012
 */
 
+#include <cstddef>
+#include <iterator>
 #include <utility>
 
 #include <boost/mpl/string.hpp>
@@ -80,6 +82,16 @@ public:
 	result_type operator()() {return e.reverse();}
 	result_type reverse() {return e();}
 
+	//! generate \p num random numbers into \p dest, and return the end of the output
+	template<typename OutIt>
+	OutIt generate(OutIt dest, std::size_t num) {return e.reverse_generate(dest, num);}
+	//! generate \p num random numbers in reverse into \p dest, and return the end of the output
+	template<typename OutIt>
+	OutIt reverse_generate(OutIt dest, std::size_t num) {return e.generate(dest, num);}
+	//! fill <tt>[first, last)</tt> with random numbers
+	template<typename FwdIt>
+	void fill(FwdIt first, FwdIt last) {generate( first, std::distance(first, last) );}
+
 	// recall that peek(0) is the *next* generated random number
 	result_type peek(unsigned long long v) const 
 	{
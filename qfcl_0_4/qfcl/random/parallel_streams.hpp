@@ -0,0 +1,210 @@
+/* qfcl/random/parallel_streams.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef	QFCL_RANDOM_PARALLEL_STREAMS_HPP
+#define	QFCL_RANDOM_PARALLEL_STREAMS_HPP
+
+/*! \file qfcl/random/parallel_streams.hpp
+	\brief Reproducible parallel Monte Carlo with a counter-based random stream per job
+
+	A simulation is split into logical jobs, numbered from 0, independently of the number of
+	threads. Job \c j draws its random numbers from a counter-based engine (Philox or Threefry,
+	from boost_extensions) whose key is made of \c j and a seed, so its numbers do not depend on
+	which thread runs it, or when. The jobs are run on a \c work_stealing_pool, their results
+	are stored by job number, and are then combined by \c statistics::pairwise_sum, in an order
+	that depends only on the number of jobs. So the result is bit for bit the same for any
+	number of threads, and from run to run.
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/random/counter_based_engine.hpp>
+
+#include <qfcl/statistics/summation.hpp>
+#include <qfcl/utility/work_stealing_pool.hpp>
+
+namespace qfcl {
+
+namespace random {
+
+/*! \ingroup random
+	@{
+*/
+
+/*! \brief The random streams of the jobs of a simulation, for a counter-based PRF
+
+	The key of job \c j holds \c j in its low half, and the seed in its high half, each up to
+	64 bits: so 32 bits each for the 64 bit key of \c philox<4, uint32_t>, and 64 each for keys
+	of 128 bits or more. Distinct (seed, job) pairs give distinct keys, and so independent
+	streams.
+*/
+template<class Prf>
+class counter_based_streams
+{
+public:
+	typedef Prf										prf_type;
+	typedef typename Prf::key_type					key_type;
+	typedef boost::random::counter_based_engine<Prf> engine_type;
+
+	//! \throw std::out_of_range if \p seed does not fit in half the key
+	explicit counter_based_streams(boost::uint64_t seed = 0)
+		: seed_(seed)
+	{
+		// in two steps, as half_bits may be 64
+		if ( ( (seed >> (half_bits - 1)) >> 1 ) != 0 )
+			throw std::out_of_range("counter_based_streams: the seed does not fit in half the key");
+	}
+
+	boost::uint64_t seed() const {return seed_;}
+
+	//! the largest job number
+	static boost::uint64_t max_job() {return ~boost::uint64_t(0) >> (64 - half_bits);}
+
+	/*! \brief The key of job \p job
+		\throw std::out_of_range if \p job is greater than \c max_job()
+	*/
+	key_type key(boost::uint64_t job) const
+	{
+		if ( job > max_job() )
+			throw std::out_of_range("counter_based_streams: job number out of range");
+
+		key_type k = {{}};
+		put(k, 0, job);
+		put(k, half_words, seed_);
+
+		return k;
+	}
+
+	//! a new engine for job \p job, at the start of its stream
+	engine_type engine(boost::uint64_t job) const
+	{
+		return engine_type( key(job) );
+	}
+
+	/*! \brief Runs the jobs <tt>0, ..., jobs - 1</tt> on \p pool, and returns the sum of their results
+
+		Job \c j is <tt>f(j, e)</tt>, for \c e a new engine for the job; \p f is called from the
+		threads of the pool at the same time. The results are combined by \c statistics::pairwise_sum,
+		so the sum is reproducible when they are floating point, and accurate when they are
+		\c statistics::compensated_sum or \c monte_carlo_sums.
+	*/
+	template<typename F>
+	typename std::result_of<F (boost::uint64_t, engine_type &)>::type
+	sum(work_stealing_pool & pool, std::size_t jobs, F f) const
+	{
+		typedef typename std::result_of<F (boost::uint64_t, engine_type &)>::type result_type;
+
+		if (jobs != 0)
+			key(jobs - 1);	// checks the range of the job numbers
+
+		std::vector<result_type> results(jobs);
+		pool.parallel_for( jobs, [&] (std::size_t j) {
+			engine_type e = engine(j);
+			results[j] = f(j, e);
+		} );
+
+		return statistics::pairwise_sum( results.begin(), results.end() );
+	}
+private:
+	typedef typename key_type::value_type kvalue_type;
+	static const int kvalue_bits = std::numeric_limits<kvalue_type>::digits;
+	static const std::size_t key_size = key_type::static_size;
+	static const std::size_t half_words = key_size / 2;
+	static const int half_bits = half_words * kvalue_bits < 64 ? static_cast<int>(half_words) * kvalue_bits : 64;
+
+	static_assert(key_size % 2 == 0 && half_bits >= 32,
+		"counter_based_streams: the key must have an even number of words, and at least 64 bits");
+
+	//! puts \p x in the words of \p k from \p first, low first
+	static void put(key_type & k, std::size_t first, boost::uint64_t x)
+	{
+		for (std::size_t j = first; j < first + half_words && x != 0; ++j)
+		{
+			k[j] = static_cast<kvalue_type>(x);
+			// in two steps, in case kvalue_type has 64 bits
+			x >>= kvalue_bits / 2;
+			x >>= kvalue_bits / 2;
+		}
+	}
+
+	boost::uint64_t seed_;
+};
+
+/*! \brief The sums of the samples of a Monte Carlo estimate
+
+	A job adds its samples with \c add, and the sums of the jobs are combined by
+	\c counter_based_streams::sum. The sums are compensated, so the estimate is accurate as well
+	as reproducible.
+*/
+template<typename RealType = double>
+class monte_carlo_sums
+{
+public:
+	monte_carlo_sums() : count_(0) {}
+
+	//! adds the \p n samples \p x[0], ..., \p x[n - 1]
+	void add(const RealType * x, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			sum_ += x[i];
+			sum_squares_ += x[i] * x[i];
+		}
+		count_ += n;
+	}
+
+	monte_carlo_sums & operator+=(const monte_carlo_sums & other)
+	{
+		sum_ += other.sum_;
+		sum_squares_ += other.sum_squares_;
+		count_ += other.count_;
+
+		return *this;
+	}
+
+	friend monte_carlo_sums operator+(monte_carlo_sums a, const monte_carlo_sums & b)
+	{
+		return a += b;
+	}
+
+	boost::uint64_t count() const {return count_;}
+
+	//! the sample mean
+	RealType mean() const {return sum_.value() / count_;}
+
+	//! the standard error of the mean, from the sample variance
+	RealType standard_error() const
+	{
+		const RealType m = mean();
+		const RealType variance = (sum_squares_.value() - count_ * m * m) / (count_ - 1);
+
+		return std::sqrt( (variance > 0 ? variance : 0) / count_ );
+	}
+private:
+	statistics::compensated_sum<RealType> sum_;
+	statistics::compensated_sum<RealType> sum_squares_;
+	boost::uint64_t count_;
+};
+
+//! @}
+
+}	// namespace random
+
+}	// namespace qfcl
+
+#endif	// QFCL_RANDOM_PARALLEL_STREAMS_HPP
@@ -6,11 +6,15 @@
 #ifndef QFCL_RANDOM_VARIATE_GENERATOR_HPP
 #define QFCL_RANDOM_VARIATE_GENERATOR_HPP
 
+#include <cstddef>
 
 namespace qfcl {
 namespace random {
 
 
+// Engine may be a reference type, as for boost::variate_generator<Engine&, Distribution>: then the 
+// generator uses the caller's engine, which is advanced, instead of a copy of it. This avoids copying
+// the state of large engines, such as the 2.5KB of mt19937, when a generator is constructed per sample.
 template<class Engine, class Distribution >
 class variate_generator
 {
@@ -18,12 +22,34 @@ public:
 	typedef	Engine			engine_type;
 	typedef Distribution	distribution_type;
 
-    variate_generator(Engine e, Distribution d)
+    variate_generator(const engine_type & e, const distribution_type & d)
     {
         Engine::UNSUPPORTED_ENGINE_DISTRIBUTION_COMBINATION;
         Distribution::UNSUPPORTED_ENGINE_DISTRIBUTION_COMBINATION;
     }
 };
 
+// Transforms a whole block of engine outputs into variates, for buffered_variate_generator.
+// Distributions that can do this in one pass specialize it with supported = true and
+//   template<class UIntType>
+//   static void apply(const Distribution & d, const UIntType * x, result_type * out, std::size_t n, UIntType min_, UIntType max_)
+// where x holds block_transform_outputs<Distribution, UIntType>::value * n engine outputs in [min_, max_].
+template<class Distribution>
+struct block_transform
+{
+    static const bool supported = false;
+};
+
+// The number of engine outputs, of type UIntType, that block_transform<Distribution> uses per variate.
+// for_bits(bits) is the number for an engine with bits random bits per output; when it is more than
+// value, buffered_variate_generator generates that many per variate instead.
+template<class Distribution, typename UIntType>
+struct block_transform_outputs
+{
+    static const std::size_t value = 1;
+
+    static std::size_t for_bits(unsigned) {return value;}
+};
+
 }} // namespaces
 #endif //
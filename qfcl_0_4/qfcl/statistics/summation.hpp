@@ -0,0 +1,107 @@
+/* qfcl/statistics/summation.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef	QFCL_STATISTICS_SUMMATION_HPP
+#define	QFCL_STATISTICS_SUMMATION_HPP
+
+/*! \file qfcl/statistics/summation.hpp
+	\brief Floating point sums that are accurate, and reproducible when computed in parallel
+
+	Floating point addition is not associative, so a sum depends on the order of its terms. A
+	sum computed in parallel is made reproducible by computing the partial sums of a fixed
+	partition of the terms, and combining them in a fixed order: \c pairwise_sum does so along
+	the balanced binary tree determined by the number of partial sums alone. Within a partial
+	sum, \c compensated_sum keeps the rounding error of the running sum, which makes the result
+	nearly independent of the order as well as more accurate.
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+
+namespace qfcl {
+
+namespace statistics {
+
+/*! \brief A running sum with the compensation of A. Neumaier
+
+	The rounding error of each addition is accumulated separately, and added back by
+	\c value(). The error of the result is about one rounding, rather than one per term.
+*/
+template<typename RealType = double>
+class compensated_sum
+{
+public:
+	compensated_sum() : sum_(0), compensation_(0) {}
+
+	explicit compensated_sum(RealType x) : sum_(x), compensation_(0) {}
+
+	compensated_sum & operator+=(RealType x)
+	{
+		const RealType t = sum_ + x;
+		// the low order bits lost from the larger of sum_ and x
+		if ( std::fabs(sum_) >= std::fabs(x) )
+			compensation_ += (sum_ - t) + x;
+		else
+			compensation_ += (x - t) + sum_;
+		sum_ = t;
+
+		return *this;
+	}
+
+	//! adds the terms and the compensation of \p other
+	compensated_sum & operator+=(const compensated_sum & other)
+	{
+		*this += other.sum_;
+		compensation_ += other.compensation_;
+
+		return *this;
+	}
+
+	friend compensated_sum operator+(compensated_sum a, const compensated_sum & b)
+	{
+		return a += b;
+	}
+
+	RealType value() const {return sum_ + compensation_;}
+private:
+	RealType sum_;
+	RealType compensation_;
+};
+
+/*! \brief The sum of <tt>[first, last)</tt>, added in a balanced binary tree
+
+	The range is split at its midpoint, <tt>n / 2</tt> for \c n terms, and the sums of the halves
+	are added, recursively; so the order of the additions depends only on \c n. The terms may be
+	of any type with \c +, such as \c compensated_sum. Returns \c T() for an empty range.
+*/
+template<typename RandomAccessIterator>
+typename std::iterator_traits<RandomAccessIterator>::value_type
+pairwise_sum(RandomAccessIterator first, RandomAccessIterator last)
+{
+	typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+	const std::ptrdiff_t n = last - first;
+	if (n == 0)
+		return T();
+	if (n == 1)
+		return *first;
+
+	const RandomAccessIterator middle = first + n / 2;
+	return pairwise_sum(first, middle) + pairwise_sum(middle, last);
+}
+
+}	// namespace statistics
+
+}	// namespace qfcl
+
+#endif	// QFCL_STATISTICS_SUMMATION_HPP
@@ -0,0 +1,555 @@
+/* qfcl/utility/simd.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef QFCL_SIMD_HPP
+#define QFCL_SIMD_HPP
+
+/*! \file qfcl/utility/simd.hpp
+	\brief Compile time selection of SIMD instruction sets, and thin wrappers for vector operations.
+
+	The instruction set is determined by the compiler flags (e.g. \c -mavx2 or \c /arch:AVX2).
+	Defining \c QFCL_NO_SIMD disables all SIMD code paths.
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+#if !defined(QFCL_NO_SIMD)
+#if defined(__AVX512F__)
+//! AVX-512 foundation instructions are available
+#define QFCL_SIMD_AVX512
+#endif
+#if defined(__AVX2__)
+//! AVX2 integer instructions are available
+#define QFCL_SIMD_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+//! SSE2 integer instructions are available
+#define QFCL_SIMD_SSE2
+#endif
+#endif	// !QFCL_NO_SIMD
+
+#if defined(QFCL_SIMD_AVX2) || defined(QFCL_SIMD_AVX512)
+#include <immintrin.h>
+#elif defined(QFCL_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace qfcl {
+
+//! SIMD support
+namespace simd {
+
+/*! \brief Integer vector operations on lanes of type \p UIntType, for the widest available instruction set
+
+	The member \c type is \c void if there is no SIMD support for \p UIntType. Otherwise \c type
+	provides \c lanes, \c load, \c store, \c set1, \c and_, \c or_, \c xor_, \c srli, \c slli
+	and \c low_bit_mask, where <tt>low_bit_mask(v)</tt> has all bits set in the lanes where
+	\c v is odd.
+*/
+template<typename UIntType, std::size_t bytes = sizeof(UIntType)>
+struct vector_ops
+{
+	typedef void type;
+};
+
+#if defined(QFCL_SIMD_SSE2)
+
+//! SSE2 operations on 32-bit lanes
+struct sse2_u32
+{
+	typedef __m128i vector;
+	typedef boost::uint32_t value_type;
+	static const std::size_t lanes = 4;
+
+	static vector load(const void * p) {return _mm_loadu_si128( static_cast<const __m128i *>(p) );}
+	static void store(void * p, vector v) {_mm_storeu_si128( static_cast<__m128i *>(p), v );}
+	static vector set1(value_type a) {return _mm_set1_epi32( static_cast<int>(a) );}
+	static vector and_(vector a, vector b) {return _mm_and_si128(a, b);}
+	static vector or_(vector a, vector b) {return _mm_or_si128(a, b);}
+	static vector xor_(vector a, vector b) {return _mm_xor_si128(a, b);}
+	template<int k> static vector srli(vector a) {return _mm_srli_epi32(a, k);}
+	template<int k> static vector slli(vector a) {return _mm_slli_epi32(a, k);}
+	static vector low_bit_mask(vector a) {return _mm_sub_epi32( _mm_setzero_si128(), _mm_and_si128( a, _mm_set1_epi32(1) ) );}
+};
+
+//! SSE2 operations on 64-bit lanes
+struct sse2_u64
+{
+	typedef __m128i vector;
+	typedef boost::uint64_t value_type;
+	static const std::size_t lanes = 2;
+
+	static vector load(const void * p) {return _mm_loadu_si128( static_cast<const __m128i *>(p) );}
+	static void store(void * p, vector v) {_mm_storeu_si128( static_cast<__m128i *>(p), v );}
+	static vector set1(value_type a) {return _mm_set1_epi64x( static_cast<long long>(a) );}
+	static vector and_(vector a, vector b) {return _mm_and_si128(a, b);}
+	static vector or_(vector a, vector b) {return _mm_or_si128(a, b);}
+	static vector xor_(vector a, vector b) {return _mm_xor_si128(a, b);}
+	template<int k> static vector srli(vector a) {return _mm_srli_epi64(a, k);}
+	template<int k> static vector slli(vector a) {return _mm_slli_epi64(a, k);}
+	static vector low_bit_mask(vector a) {return _mm_sub_epi64( _mm_setzero_si128(), _mm_and_si128( a, _mm_set1_epi64x(1) ) );}
+};
+
+#endif	// QFCL_SIMD_SSE2
+
+#if defined(QFCL_SIMD_AVX2)
+
+//! AVX2 operations on 32-bit lanes
+struct avx2_u32
+{
+	typedef __m256i vector;
+	typedef boost::uint32_t value_type;
+	static const std::size_t lanes = 8;
+
+	static vector load(const void * p) {return _mm256_loadu_si256( static_cast<const __m256i *>(p) );}
+	static void store(void * p, vector v) {_mm256_storeu_si256( static_cast<__m256i *>(p), v );}
+	static vector set1(value_type a) {return _mm256_set1_epi32( static_cast<int>(a) );}
+	static vector and_(vector a, vector b) {return _mm256_and_si256(a, b);}
+	static vector or_(vector a, vector b) {return _mm256_or_si256(a, b);}
+	static vector xor_(vector a, vector b) {return _mm256_xor_si256(a, b);}
+	template<int k> static vector srli(vector a) {return _mm256_srli_epi32(a, k);}
+	template<int k> static vector slli(vector a) {return _mm256_slli_epi32(a, k);}
+	static vector low_bit_mask(vector a) {return _mm256_sub_epi32( _mm256_setzero_si256(), _mm256_and_si256( a, _mm256_set1_epi32(1) ) );}
+};
+
+//! AVX2 operations on 64-bit lanes
+struct avx2_u64
+{
+	typedef __m256i vector;
+	typedef boost::uint64_t value_type;
+	static const std::size_t lanes = 4;
+
+	static vector load(const void * p) {return _mm256_loadu_si256( static_cast<const __m256i *>(p) );}
+	static void store(void * p, vector v) {_mm256_storeu_si256( static_cast<__m256i *>(p), v );}
+	static vector set1(value_type a) {return _mm256_set1_epi64x( static_cast<long long>(a) );}
+	static vector and_(vector a, vector b) {return _mm256_and_si256(a, b);}
+	static vector or_(vector a, vector b) {return _mm256_or_si256(a, b);}
+	static vector xor_(vector a, vector b) {return _mm256_xor_si256(a, b);}
+	template<int k> static vector srli(vector a) {return _mm256_srli_epi64(a, k);}
+	template<int k> static vector slli(vector a) {return _mm256_slli_epi64(a, k);}
+	static vector low_bit_mask(vector a) {return _mm256_sub_epi64( _mm256_setzero_si256(), _mm256_and_si256( a, _mm256_set1_epi64x(1) ) );}
+};
+
+template<typename UIntType>
+struct vector_ops<UIntType, 4>
+{
+	typedef avx2_u32 type;
+};
+
+template<typename UIntType>
+struct vector_ops<UIntType, 8>
+{
+	typedef avx2_u64 type;
+};
+
+#elif defined(QFCL_SIMD_SSE2)
+
+template<typename UIntType>
+struct vector_ops<UIntType, 4>
+{
+	typedef sse2_u32 type;
+};
+
+template<typename UIntType>
+struct vector_ops<UIntType, 8>
+{
+	typedef sse2_u64 type;
+};
+
+#endif	// QFCL_SIMD_AVX2
+
+/*! \brief Floating point vector operations on lanes of type \p RealType, for the widest available instruction set
+
+	The member \c type is \c void if there is no SIMD support for \p RealType. Otherwise \c type
+	provides \c lanes, \c load, \c store, \c set1, \c add, \c sub, \c mul, \c div, \c sqrt, \c min_,
+	the comparison <tt>less(a, b)</tt> returning a \c mask, <tt>select(m, a, b)</tt> taking the lanes
+	of \c a where \c m is set and of \c b elsewhere, <tt>any(m)</tt>, and for positive normal \c v,
+	<tt>exponent(v)</tt> \f$= \lfloor \log_2 v \rfloor\f$ and <tt>mantissa(v)</tt> \f$= v 2^{-\mathrm{exponent}(v)}\f$.
+	Also <tt>fill_mantissa(p)</tt> loads unsigned integers of the same size as \c value_type from \c p,
+	and gives the numbers in [1, 2) whose mantissas are their highest bits, and <tt>pow2(k)</tt>
+	\f$= 2^k\f$ for integer valued \c k in the range of normal exponents.
+*/
+template<typename RealType>
+struct real_ops
+{
+	typedef void type;
+};
+
+#if defined(QFCL_SIMD_SSE2)
+
+//! SSE2 operations on \c double lanes
+struct sse2_f64
+{
+	typedef __m128d vector;
+	typedef __m128d mask;
+	typedef double value_type;
+	static const std::size_t lanes = 2;
+
+	static vector load(const double * p) {return _mm_loadu_pd(p);}
+	static void store(double * p, vector v) {_mm_storeu_pd(p, v);}
+	static vector set1(double a) {return _mm_set1_pd(a);}
+	static vector add(vector a, vector b) {return _mm_add_pd(a, b);}
+	static vector sub(vector a, vector b) {return _mm_sub_pd(a, b);}
+	static vector mul(vector a, vector b) {return _mm_mul_pd(a, b);}
+	static vector div(vector a, vector b) {return _mm_div_pd(a, b);}
+	static vector sqrt(vector a) {return _mm_sqrt_pd(a);}
+	static vector min_(vector a, vector b) {return _mm_min_pd(a, b);}
+	static mask less(vector a, vector b) {return _mm_cmplt_pd(a, b);}
+	static vector select(mask m, vector a, vector b) {return _mm_or_pd( _mm_and_pd(m, a), _mm_andnot_pd(m, b) );}
+	static bool any(mask m) {return _mm_movemask_pd(m) != 0;}
+	static vector exponent(vector a)
+	{
+		// the biased exponent is converted exactly by placing it in the mantissa of 2^52
+		const __m128i e = _mm_or_si128( _mm_srli_epi64(_mm_castpd_si128(a), 52), _mm_set1_epi64x(0x4330000000000000ll) );
+		return _mm_sub_pd( _mm_castsi128_pd(e), _mm_set1_pd(4503599627370496.0 + 1023) );
+	}
+	static vector mantissa(vector a)
+	{
+		const __m128i m = _mm_and_si128( _mm_castpd_si128(a), _mm_set1_epi64x(0x000FFFFFFFFFFFFFll) );
+		return _mm_castsi128_pd( _mm_or_si128( m, _mm_set1_epi64x(0x3FF0000000000000ll) ) );
+	}
+	static vector fill_mantissa(const void * p)
+	{
+		const __m128i m = _mm_srli_epi64( _mm_loadu_si128( static_cast<const __m128i *>(p) ), 12 );
+		return _mm_castsi128_pd( _mm_or_si128( m, _mm_set1_epi64x(0x3FF0000000000000ll) ) );
+	}
+	static vector pow2(vector k)
+	{
+		// k + 1023 is placed exactly in the mantissa of 2^52, and then shifted to the exponent
+		const __m128d e = _mm_add_pd( k, _mm_set1_pd(4503599627370496.0 + 1023) );
+		return _mm_castsi128_pd( _mm_slli_epi64(_mm_castpd_si128(e), 52) );
+	}
+};
+
+//! SSE2 operations on \c float lanes
+struct sse2_f32
+{
+	typedef __m128 vector;
+	typedef __m128 mask;
+	typedef float value_type;
+	static const std::size_t lanes = 4;
+
+	static vector load(const float * p) {return _mm_loadu_ps(p);}
+	static void store(float * p, vector v) {_mm_storeu_ps(p, v);}
+	static vector set1(float a) {return _mm_set1_ps(a);}
+	static vector add(vector a, vector b) {return _mm_add_ps(a, b);}
+	static vector sub(vector a, vector b) {return _mm_sub_ps(a, b);}
+	static vector mul(vector a, vector b) {return _mm_mul_ps(a, b);}
+	static vector div(vector a, vector b) {return _mm_div_ps(a, b);}
+	static vector sqrt(vector a) {return _mm_sqrt_ps(a);}
+	static vector min_(vector a, vector b) {return _mm_min_ps(a, b);}
+	static mask less(vector a, vector b) {return _mm_cmplt_ps(a, b);}
+	static vector select(mask m, vector a, vector b) {return _mm_or_ps( _mm_and_ps(m, a), _mm_andnot_ps(m, b) );}
+	static bool any(mask m) {return _mm_movemask_ps(m) != 0;}
+	static vector exponent(vector a)
+	{
+		const __m128i e = _mm_srli_epi32(_mm_castps_si128(a), 23);
+		return _mm_sub_ps( _mm_cvtepi32_ps(e), _mm_set1_ps(127) );
+	}
+	static vector mantissa(vector a)
+	{
+		const __m128i m = _mm_and_si128( _mm_castps_si128(a), _mm_set1_epi32(0x007FFFFF) );
+		return _mm_castsi128_ps( _mm_or_si128( m, _mm_set1_epi32(0x3F800000) ) );
+	}
+	static vector fill_mantissa(const void * p)
+	{
+		const __m128i m = _mm_srli_epi32( _mm_loadu_si128( static_cast<const __m128i *>(p) ), 9 );
+		return _mm_castsi128_ps( _mm_or_si128( m, _mm_set1_epi32(0x3F800000) ) );
+	}
+	static vector pow2(vector k)
+	{
+		const __m128 e = _mm_add_ps( k, _mm_set1_ps(8388608.0f + 127) );
+		return _mm_castsi128_ps( _mm_slli_epi32(_mm_castps_si128(e), 23) );
+	}
+};
+
+#endif	// QFCL_SIMD_SSE2
+
+#if defined(QFCL_SIMD_AVX2)
+
+//! AVX2 operations on \c double lanes
+struct avx2_f64
+{
+	typedef __m256d vector;
+	typedef __m256d mask;
+	typedef double value_type;
+	static const std::size_t lanes = 4;
+
+	static vector load(const double * p) {return _mm256_loadu_pd(p);}
+	static void store(double * p, vector v) {_mm256_storeu_pd(p, v);}
+	static vector set1(double a) {return _mm256_set1_pd(a);}
+	static vector add(vector a, vector b) {return _mm256_add_pd(a, b);}
+	static vector sub(vector a, vector b) {return _mm256_sub_pd(a, b);}
+	static vector mul(vector a, vector b) {return _mm256_mul_pd(a, b);}
+	static vector div(vector a, vector b) {return _mm256_div_pd(a, b);}
+	static vector sqrt(vector a) {return _mm256_sqrt_pd(a);}
+	static vector min_(vector a, vector b) {return _mm256_min_pd(a, b);}
+	static mask less(vector a, vector b) {return _mm256_cmp_pd(a, b, _CMP_LT_OQ);}
+	static vector select(mask m, vector a, vector b) {return _mm256_blendv_pd(b, a, m);}
+	static bool any(mask m) {return _mm256_movemask_pd(m) != 0;}
+	static vector exponent(vector a)
+	{
+		const __m256i e = _mm256_or_si256( _mm256_srli_epi64(_mm256_castpd_si256(a), 52), _mm256_set1_epi64x(0x4330000000000000ll) );
+		return _mm256_sub_pd( _mm256_castsi256_pd(e), _mm256_set1_pd(4503599627370496.0 + 1023) );
+	}
+	static vector mantissa(vector a)
+	{
+		const __m256i m = _mm256_and_si256( _mm256_castpd_si256(a), _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll) );
+		return _mm256_castsi256_pd( _mm256_or_si256( m, _mm256_set1_epi64x(0x3FF0000000000000ll) ) );
+	}
+	static vector fill_mantissa(const void * p)
+	{
+		const __m256i m = _mm256_srli_epi64( _mm256_loadu_si256( static_cast<const __m256i *>(p) ), 12 );
+		return _mm256_castsi256_pd( _mm256_or_si256( m, _mm256_set1_epi64x(0x3FF0000000000000ll) ) );
+	}
+	static vector pow2(vector k)
+	{
+		const __m256d e = _mm256_add_pd( k, _mm256_set1_pd(4503599627370496.0 + 1023) );
+		return _mm256_castsi256_pd( _mm256_slli_epi64(_mm256_castpd_si256(e), 52) );
+	}
+};
+
+//! AVX2 operations on \c float lanes
+struct avx2_f32
+{
+	typedef __m256 vector;
+	typedef __m256 mask;
+	typedef float value_type;
+	static const std::size_t lanes = 8;
+
+	static vector load(const float * p) {return _mm256_loadu_ps(p);}
+	static void store(float * p, vector v) {_mm256_storeu_ps(p, v);}
+	static vector set1(float a) {return _mm256_set1_ps(a);}
+	static vector add(vector a, vector b) {return _mm256_add_ps(a, b);}
+	static vector sub(vector a, vector b) {return _mm256_sub_ps(a, b);}
+	static vector mul(vector a, vector b) {return _mm256_mul_ps(a, b);}
+	static vector div(vector a, vector b) {return _mm256_div_ps(a, b);}
+	static vector sqrt(vector a) {return _mm256_sqrt_ps(a);}
+	static vector min_(vector a, vector b) {return _mm256_min_ps(a, b);}
+	static mask less(vector a, vector b) {return _mm256_cmp_ps(a, b, _CMP_LT_OQ);}
+	static vector select(mask m, vector a, vector b) {return _mm256_blendv_ps(b, a, m);}
+	static bool any(mask m) {return _mm256_movemask_ps(m) != 0;}
+	static vector exponent(vector a)
+	{
+		const __m256i e = _mm256_srli_epi32(_mm256_castps_si256(a), 23);
+		return _mm256_sub_ps( _mm256_cvtepi32_ps(e), _mm256_set1_ps(127) );
+	}
+	static vector mantissa(vector a)
+	{
+		const __m256i m = _mm256_and_si256( _mm256_castps_si256(a), _mm256_set1_epi32(0x007FFFFF) );
+		return _mm256_castsi256_ps( _mm256_or_si256( m, _mm256_set1_epi32(0x3F800000) ) );
+	}
+	static vector fill_mantissa(const void * p)
+	{
+		const __m256i m = _mm256_srli_epi32( _mm256_loadu_si256( static_cast<const __m256i *>(p) ), 9 );
+		return _mm256_castsi256_ps( _mm256_or_si256( m, _mm256_set1_epi32(0x3F800000) ) );
+	}
+	static vector pow2(vector k)
+	{
+		const __m256 e = _mm256_add_ps( k, _mm256_set1_ps(8388608.0f + 127) );
+		return _mm256_castsi256_ps( _mm256_slli_epi32(_mm256_castps_si256(e), 23) );
+	}
+};
+
+#endif	// QFCL_SIMD_AVX2
+
+#if defined(QFCL_SIMD_AVX512)
+
+//! AVX-512 operations on \c double lanes
+struct avx512_f64
+{
+	typedef __m512d vector;
+	typedef __mmask8 mask;
+	typedef double value_type;
+	static const std::size_t lanes = 8;
+
+	static vector load(const double * p) {return _mm512_loadu_pd(p);}
+	static void store(double * p, vector v) {_mm512_storeu_pd(p, v);}
+	static vector set1(double a) {return _mm512_set1_pd(a);}
+	static vector add(vector a, vector b) {return _mm512_add_pd(a, b);}
+	static vector sub(vector a, vector b) {return _mm512_sub_pd(a, b);}
+	static vector mul(vector a, vector b) {return _mm512_mul_pd(a, b);}
+	static vector div(vector a, vector b) {return _mm512_div_pd(a, b);}
+	static vector sqrt(vector a) {return _mm512_sqrt_pd(a);}
+	static vector min_(vector a, vector b) {return _mm512_min_pd(a, b);}
+	static mask less(vector a, vector b) {return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);}
+	static vector select(mask m, vector a, vector b) {return _mm512_mask_blend_pd(m, b, a);}
+	static bool any(mask m) {return m != 0;}
+	static vector exponent(vector a) {return _mm512_getexp_pd(a);}
+	static vector mantissa(vector a) {return _mm512_getmant_pd(a, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero);}
+	static vector fill_mantissa(const void * p)
+	{
+		const __m512i m = _mm512_srli_epi64( _mm512_loadu_si512(p), 12 );
+		return _mm512_castsi512_pd( _mm512_or_si512( m, _mm512_set1_epi64(0x3FF0000000000000ll) ) );
+	}
+	static vector pow2(vector k) {return _mm512_scalef_pd( _mm512_set1_pd(1), k );}
+};
+
+//! AVX-512 operations on \c float lanes
+struct avx512_f32
+{
+	typedef __m512 vector;
+	typedef __mmask16 mask;
+	typedef float value_type;
+	static const std::size_t lanes = 16;
+
+	static vector load(const float * p) {return _mm512_loadu_ps(p);}
+	static void store(float * p, vector v) {_mm512_storeu_ps(p, v);}
+	static vector set1(float a) {return _mm512_set1_ps(a);}
+	static vector add(vector a, vector b) {return _mm512_add_ps(a, b);}
+	static vector sub(vector a, vector b) {return _mm512_sub_ps(a, b);}
+	static vector mul(vector a, vector b) {return _mm512_mul_ps(a, b);}
+	static vector div(vector a, vector b) {return _mm512_div_ps(a, b);}
+	static vector sqrt(vector a) {return _mm512_sqrt_ps(a);}
+	static vector min_(vector a, vector b) {return _mm512_min_ps(a, b);}
+	static mask less(vector a, vector b) {return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);}
+	static vector select(mask m, vector a, vector b) {return _mm512_mask_blend_ps(m, b, a);}
+	static bool any(mask m) {return m != 0;}
+	static vector exponent(vector a) {return _mm512_getexp_ps(a);}
+	static vector mantissa(vector a) {return _mm512_getmant_ps(a, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero);}
+	static vector fill_mantissa(const void * p)
+	{
+		const __m512i m = _mm512_srli_epi32( _mm512_loadu_si512(p), 9 );
+		return _mm512_castsi512_ps( _mm512_or_si512( m, _mm512_set1_epi32(0x3F800000) ) );
+	}
+	static vector pow2(vector k) {return _mm512_scalef_ps( _mm512_set1_ps(1), k );}
+};
+
+template<>
+struct real_ops<double>
+{
+	typedef avx512_f64 type;
+};
+
+template<>
+struct real_ops<float>
+{
+	typedef avx512_f32 type;
+};
+
+#elif defined(QFCL_SIMD_AVX2)
+
+template<>
+struct real_ops<double>
+{
+	typedef avx2_f64 type;
+};
+
+template<>
+struct real_ops<float>
+{
+	typedef avx2_f32 type;
+};
+
+#elif defined(QFCL_SIMD_SSE2)
+
+template<>
+struct real_ops<double>
+{
+	typedef sse2_f64 type;
+};
+
+template<>
+struct real_ops<float>
+{
+	typedef sse2_f32 type;
+};
+
+#endif	// QFCL_SIMD_AVX512
+
+//! \f$c_0 x^{N-1} + c_1 x^{N-2} + \dots + c_{N-1}\f$ by Horner's rule, for each lane of \p x
+template<typename Ops, std::size_t N>
+typename Ops::vector polynomial(typename Ops::vector x, const double (&c)[N])
+{
+	typedef typename Ops::value_type value_type;
+
+	typename Ops::vector y = Ops::set1( static_cast<value_type>(c[0]) );
+	for (std::size_t i = 1; i < N; ++i)
+		y = Ops::add( Ops::mul(y, x), Ops::set1( static_cast<value_type>(c[i]) ) );
+
+	return y;
+}
+
+/*! \brief the natural logarithm of each lane of \p x, which must be positive and normal
+	
+	With \f$x = 2^e m\f$ and \f$m \in [1/\sqrt{2}, \sqrt{2})\f$, \f$\log x = e \log 2 + 2 \,\mathrm{artanh}\, s\f$
+	where \f$s = (m - 1)/(m + 1)\f$ and \f$|s| < 0.172\f$, using enough terms of the series for 
+	\f$\mathrm{artanh}\f$ to give the full precision of \c Ops::value_type.
+*/
+template<typename Ops>
+typename Ops::vector log(typename Ops::vector x)
+{
+	typedef typename Ops::vector vector;
+	typedef typename Ops::value_type value_type;
+
+	// 2 / (2k + 1)
+	static const double double_terms[] = {2.0/19, 2.0/17, 2.0/15, 2.0/13, 2.0/11, 2.0/9, 2.0/7, 2.0/5, 2.0/3, 2.0};
+	static const double float_terms[] = {2.0/9, 2.0/7, 2.0/5, 2.0/3, 2.0};
+
+	vector e = Ops::exponent(x);
+	vector m = Ops::mantissa(x);
+
+	const typename Ops::mask large = Ops::less( Ops::set1( static_cast<value_type>(1.4142135623730951) ), m );
+	m = Ops::select( large, Ops::mul( m, Ops::set1( static_cast<value_type>(0.5) ) ), m );
+	e = Ops::select( large, Ops::add( e, Ops::set1( static_cast<value_type>(1) ) ), e );
+
+	const vector one = Ops::set1( static_cast<value_type>(1) );
+	const vector s = Ops::div( Ops::sub(m, one), Ops::add(m, one) );
+	const vector s2 = Ops::mul(s, s);
+	const vector series = sizeof(value_type) > sizeof(float) ? polynomial<Ops>(s2, double_terms) : polynomial<Ops>(s2, float_terms);
+
+	return Ops::add( Ops::mul( e, Ops::set1( static_cast<value_type>(0.69314718055994531) ) ), Ops::mul(s, series) );
+}
+
+/*! \brief the exponential of each lane of \p x
+
+	With \f$x = k \log 2 + r\f$, \f$k\f$ the nearest integer to \f$x / \log 2\f$ and \f$|r| \le \log 2 / 2\f$,
+	\f$e^x = 2^k e^r\f$, using the Taylor series of \f$e^r\f$ to the full precision of \c Ops::value_type.
+	\f$\log 2\f$ is split into a part with few bits and a remainder (Cody and Waite), so that \f$r\f$
+	is exact. \p x is clamped to the range where \f$e^x\f$ is finite and normal.
+*/
+template<typename Ops>
+typename Ops::vector exp(typename Ops::vector x)
+{
+	typedef typename Ops::vector vector;
+	typedef typename Ops::value_type value_type;
+
+	// 1/k!, from k = 13 (7 for float) down to 0
+	static const double double_terms[] = {1.0/6227020800, 1.0/479001600, 1.0/39916800, 1.0/3628800, 1.0/362880,
+		1.0/40320, 1.0/5040, 1.0/720, 1.0/120, 1.0/24, 1.0/6, 1.0/2, 1.0, 1.0};
+	static const double float_terms[] = {1.0/5040, 1.0/720, 1.0/120, 1.0/24, 1.0/6, 1.0/2, 1.0, 1.0};
+
+	const bool is_double = sizeof(value_type) > sizeof(float);
+	// adding and subtracting 1.5 * 2^(mantissa bits) rounds to the nearest integer
+	const vector round = Ops::set1( static_cast<value_type>(is_double ? 6755399441055744.0 : 12582912.0) );
+	const vector lo = Ops::set1( static_cast<value_type>(is_double ? -708.0 : -87.0) );
+	const vector hi = Ops::set1( static_cast<value_type>(is_double ? 709.0 : 88.0) );
+
+	x = Ops::min_(x, hi);
+	x = Ops::select( Ops::less(x, lo), lo, x );
+
+	const vector k = Ops::sub( Ops::add( Ops::mul( x, Ops::set1( static_cast<value_type>(1.4426950408889634) ) ), round ), round );
+	vector r = Ops::sub( x, Ops::mul( k, Ops::set1( static_cast<value_type>(is_double ? 0.693145751953125 : 0.693359375) ) ) );
+	r = Ops::sub( r, Ops::mul( k, Ops::set1( static_cast<value_type>(is_double ? 1.42860682030941723212e-6 : -2.12194440e-4) ) ) );
+
+	const vector series = is_double ? polynomial<Ops>(r, double_terms) : polynomial<Ops>(r, float_terms);
+
+	return Ops::mul( series, Ops::pow2(k) );
+}
+
+}	// namespace simd
+
+}	// namespace qfcl
+
+#endif	// QFCL_SIMD_HPP
@@ -17,6 +17,9 @@
 	\date September 28, 2012
 */
 
+#include <cstddef>
+#include <utility>
+
 #include <boost/mpl/bool.hpp>
 namespace mpl = boost::mpl;
 #include <boost/type_traits.hpp>
@@ -60,6 +63,21 @@ struct is_named
 {
 };
 
+namespace detail {
+	template<typename T>
+	static RT1 generate_test( decltype( std::declval<T &>().generate( 
+		static_cast<typename T::result_type *>(nullptr), std::size_t() ) ) * );
+	template<typename T>
+	static RT2 generate_test(...);
+}	// namespace detail
+
+//! whether the random engine \c T has the bulk member function <tt>generate(result_type * dest, size_t num)</tt>
+template<typename T>
+struct has_generate
+	: mpl::bool_<sizeof(detail::generate_test<T>(nullptr)) == 1>
+{
+};
+
 }	// namespace traits
 
 }	// namespace qfcl
@@ -0,0 +1,248 @@
+/* qfcl/utility/work_stealing_pool.hpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#ifndef	QFCL_UTILITY_WORK_STEALING_POOL_HPP
+#define	QFCL_UTILITY_WORK_STEALING_POOL_HPP
+
+/*! \file qfcl/utility/work_stealing_pool.hpp
+	\brief A pool of threads running loops, balanced by work stealing
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace qfcl {
+
+/*! \brief Runs the iterations of a loop on a fixed set of threads
+
+	\c parallel_for(n, f) calls \c f(i) once for each \c i in <tt>[0, n)</tt>. Each thread starts
+	with a contiguous range of the indices, and takes them from its front. A thread whose range
+	is empty steals the upper half of the range of another, so the work is balanced even when
+	the iterations take unequal times or the threads are unevenly scheduled. The thread calling
+	\c parallel_for is one of the workers.
+
+	Which thread runs an iteration, and when, is not determined, so \p f must not depend on it:
+	results written to an array indexed by \c i, and combined afterwards, do not.
+*/
+class work_stealing_pool
+{
+public:
+	//! \p threads workers, including the caller; 0 for one per hardware thread
+	explicit work_stealing_pool(unsigned threads = 0)
+		: generation_(0), active_(0), stop_(false), cancelled_(false)
+	{
+		if (threads == 0)
+			threads = std::thread::hardware_concurrency();
+		if (threads == 0)
+			threads = 1;
+
+		for (unsigned w = 0; w < threads; ++w)
+			ranges_.push_back( std::unique_ptr<range>(new range) );
+		// reserved first, so that push_back cannot fail with a started thread in hand
+		threads_.reserve(threads - 1);
+		try
+		{
+			for (unsigned w = 1; w < threads; ++w)
+				threads_.push_back( std::thread(&work_stealing_pool::worker, this, w) );
+		}
+		catch (...)
+		{
+			// the destructor is not run, and a joinable thread would terminate the program
+			stop();
+			throw;
+		}
+	}
+
+	~work_stealing_pool() {stop();}
+
+	//! the number of workers
+	unsigned size() const {return static_cast<unsigned>( ranges_.size() );}
+
+	/*! \brief Calls \p f(i) for \c i in <tt>[0, n)</tt>, and returns when all the calls have returned
+
+		If a call throws, the remaining iterations are skipped and the first exception is
+		rethrown. Calls from several threads are run one after the other.
+	*/
+	template<typename F>
+	void parallel_for(std::size_t n, F f)
+	{
+		if (n == 0)
+			return;
+
+		std::lock_guard<std::mutex> run(run_mutex_);
+
+		task_ = f;
+		error_ = std::exception_ptr();
+		cancelled_ = false;
+
+		const std::size_t W = ranges_.size();
+		for (std::size_t w = 0; w < W; ++w)
+		{
+			std::lock_guard<std::mutex> lock(ranges_[w]->mutex);
+			ranges_[w]->begin = n / W * w + (w < n % W ? w : n % W);
+			ranges_[w]->end = ranges_[w]->begin + n / W + (w < n % W ? 1 : 0);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			++generation_;
+			active_ = threads_.size();
+		}
+		start_.notify_all();
+
+		work(0);
+
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			done_.wait( lock, [this] () {return active_ == 0;} );
+		}
+		task_ = std::function<void (std::size_t)>();
+
+		if (error_)
+			std::rethrow_exception(error_);
+	}
+private:
+	//! stops and joins the workers
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		start_.notify_all();
+		for (std::size_t w = 0; w < threads_.size(); ++w)
+			threads_[w].join();
+	}
+
+	//! the indices <tt>[begin, end)</tt> left to a worker
+	struct range
+	{
+		range() : begin(0), end(0) {}
+
+		std::mutex mutex;
+		std::size_t begin;
+		std::size_t end;
+	};
+
+	void worker(unsigned w)
+	{
+		unsigned long seen = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				start_.wait( lock, [&] () {return stop_ || generation_ != seen;} );
+				if (stop_)
+					return;
+				seen = generation_;
+			}
+
+			work(w);
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (--active_ == 0)
+				done_.notify_one();
+		}
+	}
+
+	void work(unsigned w)
+	{
+		std::size_t i;
+		while ( take(w, i) || steal(w, i) )
+		{
+			if (cancelled_)
+				continue;
+			try
+			{
+				task_(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (!error_)
+					error_ = std::current_exception();
+				cancelled_ = true;
+			}
+		}
+	}
+
+	//! the next index of worker \p w's own range
+	bool take(unsigned w, std::size_t & i)
+	{
+		range & r = *ranges_[w];
+		std::lock_guard<std::mutex> lock(r.mutex);
+		if (r.begin == r.end)
+			return false;
+		i = r.begin++;
+
+		return true;
+	}
+
+	//! moves the upper half of another worker's range to \p w, and takes its first index
+	bool steal(unsigned w, std::size_t & i)
+	{
+		const std::size_t W = ranges_.size();
+		for (std::size_t k = 1; k < W; ++k)
+		{
+			range & victim = *ranges_[(w + k) % W];
+			std::size_t begin, end;
+			{
+				std::lock_guard<std::mutex> lock(victim.mutex);
+				if (victim.begin == victim.end)
+					continue;
+				end = victim.end;
+				begin = victim.begin + (victim.end - victim.begin) / 2;
+				victim.end = begin;
+			}
+
+			// our range is empty, so no one else takes from it in the meantime
+			range & r = *ranges_[w];
+			std::lock_guard<std::mutex> lock(r.mutex);
+			i = begin;
+			r.begin = begin + 1;
+			r.end = end;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	std::vector< std::unique_ptr<range> > ranges_;
+	std::vector<std::thread> threads_;
+
+	//! serializes the calls of parallel_for
+	std::mutex run_mutex_;
+	std::function<void (std::size_t)> task_;
+
+	//! guards the following, except cancelled_
+	std::mutex mutex_;
+	std::condition_variable start_;
+	std::condition_variable done_;
+	unsigned long generation_;
+	std::size_t active_;
+	bool stop_;
+	std::exception_ptr error_;
+
+	std::atomic<bool> cancelled_;
+};
+
+}	// namespace qfcl
+
+#endif	// QFCL_UTILITY_WORK_STEALING_POOL_HPP
@@ -0,0 +1,142 @@
+/* test/buffered_variate_generator.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+#include <qfcl/random/buffered_variate_generator.hpp>
+#include <qfcl/random/distribution/normal_inversion.hpp>
+#include <qfcl/random/distribution/normal_ziggurat.hpp>
+#include <qfcl/random/distribution/uniform_0ex_1ex.hpp>
+#include <qfcl/random/distribution/uniform_0ex_1in.hpp>
+#include <qfcl/random/distribution/uniform_0in_1ex.hpp>
+#include <qfcl/random/distribution/uniform_0in_1in.hpp>
+#include <qfcl/random/engine/mersenne_twister.hpp>
+
+namespace {
+
+// more than a few blocks, and not a multiple of the block size
+const std::size_t sample_size = 5000;
+
+//! the first \c sample_size variates of the unbuffered \c variate_generator
+template<class Engine, class Distribution>
+std::vector<typename Distribution::result_type> unbuffered_sample()
+{
+	Engine eng;
+	qfcl::random::variate_generator<Engine, Distribution> rng( eng, Distribution() );
+
+	std::vector<typename Distribution::result_type> x(sample_size);
+	for (std::size_t i = 0; i < sample_size; ++i)
+		x[i] = rng();
+
+	return x;
+}
+
+//! the first \c sample_size variates of the \c buffered_variate_generator, drawn singly and in runs of various lengths
+template<class Engine, class Distribution, std::size_t BlockSize>
+std::vector<typename Distribution::result_type> buffered_sample()
+{
+	Engine eng;
+	qfcl::random::buffered_variate_generator<Engine, Distribution, BlockSize> rng( eng, Distribution() );
+
+	std::vector<typename Distribution::result_type> x(sample_size);
+	std::size_t i = 0;
+	for (std::size_t run = 0; i < sample_size; ++run)
+	{
+		x[i++] = rng();
+		const std::size_t m = std::min( run * 37 % 300, sample_size - i );
+		rng.generate( x.begin() + i, m );
+		i += m;
+	}
+
+	return x;
+}
+
+}	// anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(buffered)
+
+// engines with and without a bulk generate
+typedef boost::mpl::list<qfcl::random::mt19937, qfcl::random::mt19937_64, boost::random::mt19937> engines;
+
+//! only a qfcl engine has the bulk generate
+BOOST_AUTO_TEST_CASE(has_generate)
+{
+	BOOST_CHECK( qfcl::traits::has_generate<qfcl::random::mt19937>::value );
+	BOOST_CHECK( qfcl::traits::has_generate<qfcl::random::reverse_mt19937_64>::value );
+	BOOST_CHECK( !qfcl::traits::has_generate<boost::random::mt19937>::value );
+}
+
+//! the buffered uniforms are identical to the unbuffered ones
+BOOST_AUTO_TEST_CASE_TEMPLATE(uniform, Engine, engines)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the buffered uniform distributions ...");
+
+	BOOST_CHECK( (buffered_sample<Engine, uniform_0ex_1ex<>, 1024>() == unbuffered_sample<Engine, uniform_0ex_1ex<> >()) );
+	BOOST_CHECK( (buffered_sample<Engine, uniform_0ex_1in<>, 256>() == unbuffered_sample<Engine, uniform_0ex_1in<> >()) );
+	BOOST_CHECK( (buffered_sample<Engine, uniform_0in_1ex<>, 4096>() == unbuffered_sample<Engine, uniform_0in_1ex<> >()) );
+	BOOST_CHECK( (buffered_sample<Engine, uniform_0in_1in<float>, 1000>() == unbuffered_sample<Engine, uniform_0in_1in<float> >()) );
+}
+
+//! the batch inverse normal cdf agrees with the scalar one
+BOOST_AUTO_TEST_CASE_TEMPLATE(normal_inversion, Engine, engines)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the buffered normal_inversion_distribution ...");
+
+	typedef normal_inversion_distribution<double, inversion::as241> distribution;
+	const std::vector<double> x = buffered_sample<Engine, distribution, 1024>();
+	const std::vector<double> y = unbuffered_sample<Engine, distribution>();
+
+	for (std::size_t i = 0; i < sample_size; ++i)
+		BOOST_CHECK_SMALL( (x[i] - y[i]) / std::max( 1.0, std::fabs(y[i]) ), 1e-14 );
+
+	typedef std_normal_inversion_distribution<float, inversion::acklam> float_distribution;
+	const std::vector<float> u = buffered_sample<Engine, float_distribution, 512>();
+	const std::vector<float> v = unbuffered_sample<Engine, float_distribution>();
+
+	for (std::size_t i = 0; i < sample_size; ++i)
+		BOOST_CHECK_SMALL( (u[i] - v[i]) / std::max( 1.0f, std::fabs(v[i]) ), 1e-6f );
+}
+
+//! distributions without a block transformation are buffered from the variate_generator
+BOOST_AUTO_TEST_CASE_TEMPLATE(ziggurat, Engine, engines)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the buffered normal_ziggurat ...");
+
+	BOOST_CHECK( (buffered_sample<Engine, normal_ziggurat<>, 1024>() == unbuffered_sample<Engine, normal_ziggurat<> >()) );
+}
+
+//! with a reference to the engine, the engine is advanced
+BOOST_AUTO_TEST_CASE(engine_reference)
+{
+	using namespace qfcl::random;
+
+	mt19937 eng, expected;
+	buffered_variate_generator<mt19937 &, uniform_0ex_1ex<>, 256> rng( eng, uniform_0ex_1ex<>() );
+
+	rng();
+	expected.discard(256);
+	BOOST_CHECK( eng == expected );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
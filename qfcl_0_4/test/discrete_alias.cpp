@@ -0,0 +1,160 @@
+/* test/discrete_alias.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+
+#include <qfcl/random/buffered_variate_generator.hpp>
+#include <qfcl/random/distribution/discrete_alias.hpp>
+#include <qfcl/random/engine/mersenne_twister.hpp>
+
+namespace {
+
+const std::size_t sample_size = 1000000;
+
+//! uneven weights, with some outcomes impossible
+std::vector<double> test_weights(std::size_t n)
+{
+	std::vector<double> w(n);
+	for (std::size_t i = 0; i < n; ++i)
+		w[i] = i % 7 == 3 ? 0 : 1 + std::sin( static_cast<double>(i) ) + (i % 50 == 0 ? 20 : 0);
+
+	return w;
+}
+
+//! an engine with 15 bits per output, like \c cpp_rand where \c RAND_MAX is 32767
+class narrow_engine
+{
+public:
+	typedef int result_type;
+
+	static result_type min() {return 0;}
+	static result_type max() {return 32767;}
+
+	result_type operator()() {return static_cast<result_type>( _eng() >> 17 );}
+private:
+	qfcl::random::mt19937 _eng;
+};
+
+}	// anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(discrete_alias)
+
+//! the alias table reproduces the probabilities, to the resolution of its thresholds
+BOOST_AUTO_TEST_CASE(table)
+{
+	BOOST_TEST_MESSAGE("Testing the alias table of discrete_alias_distribution ...");
+
+	const std::size_t sizes[] = {1, 2, 3, 17, 1000, 100000};
+	for (std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+	{
+		const std::vector<double> w = test_weights(sizes[k]);
+		double sum = 0;
+		for (std::size_t i = 0; i < w.size(); ++i)
+			sum += w[i];
+
+		const qfcl::random::discrete_alias_distribution<> d( w.begin(), w.end() );
+		BOOST_REQUIRE_EQUAL( d.size(), w.size() );
+
+		const std::vector<double> p = d.probabilities();
+		for (std::size_t i = 0; i < w.size(); ++i)
+			BOOST_REQUIRE_SMALL( p[i] - w[i] / sum, 1e-9 );
+	}
+
+	BOOST_CHECK_THROW( qfcl::random::discrete_alias_distribution<>( std::vector<double>() ), std::invalid_argument );
+	BOOST_CHECK_THROW( qfcl::random::discrete_alias_distribution<>( std::vector<double>(3, 0.0) ), std::invalid_argument );
+	BOOST_CHECK_THROW( qfcl::random::discrete_alias_distribution<>( std::vector<double>(1, -1.0) ), std::invalid_argument );
+}
+
+// engines with 32 and 64 bit outputs
+typedef boost::mpl::list<qfcl::random::mt19937, qfcl::random::mt19937_64> engines;
+
+//! the frequencies agree with the probabilities, and the buffered generator gives the same variates
+BOOST_AUTO_TEST_CASE_TEMPLATE(frequencies, Engine, engines)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the frequencies of discrete_alias_distribution ...");
+
+	const std::vector<double> w = test_weights(1000);
+	double sum = 0;
+	for (std::size_t i = 0; i < w.size(); ++i)
+		sum += w[i];
+
+	const discrete_alias_distribution<> d(w);
+	Engine eng;
+	variate_generator<Engine, discrete_alias_distribution<> > rng(eng, d);
+	buffered_variate_generator<Engine, discrete_alias_distribution<>, 1000> buffered(eng, d);
+
+	std::vector<int> x(sample_size), y(sample_size);
+	rng.generate( x.begin(), sample_size );
+	buffered.generate( y.begin(), sample_size );
+	BOOST_CHECK( x == y );
+
+	std::vector<double> count( w.size() );
+	for (std::size_t i = 0; i < sample_size; ++i)
+	{
+		BOOST_REQUIRE( 0 <= x[i] && x[i] < static_cast<int>( w.size() ) );
+		++count[ x[i] ];
+	}
+
+	// Pearson's statistic, for about 857 degrees of freedom
+	double chi2 = 0;
+	std::size_t dof = 0;
+	for (std::size_t i = 0; i < w.size(); ++i)
+	{
+		const double expected = sample_size * w[i] / sum;
+		if (expected == 0)
+		{
+			BOOST_CHECK_EQUAL( count[i], 0 );
+			continue;
+		}
+		chi2 += (count[i] - expected) * (count[i] - expected) / expected;
+		++dof;
+	}
+	BOOST_CHECK_SMALL( (chi2 - dof) / std::sqrt(2.0 * dof), 4.0 );
+}
+
+//! all 64 bits of a variate are random for an engine with fewer than 32 bits per output, so the aliases are used
+BOOST_AUTO_TEST_CASE(narrow_engine_frequencies)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing discrete_alias_distribution with a 15 bit engine ...");
+
+	std::vector<double> w;
+	w.push_back(1);
+	w.push_back(3);
+
+	const discrete_alias_distribution<> d(w);
+	narrow_engine eng;
+	variate_generator<narrow_engine, discrete_alias_distribution<> > rng(eng, d);
+	buffered_variate_generator<narrow_engine, discrete_alias_distribution<>, 1000> buffered(eng, d);
+
+	std::vector<int> x(sample_size), y(sample_size);
+	rng.generate( x.begin(), sample_size );
+	buffered.generate( y.begin(), sample_size );
+	BOOST_CHECK( x == y );
+
+	std::size_t ones = 0;
+	for (std::size_t i = 0; i < sample_size; ++i)
+		ones += x[i];
+
+	// the standard deviation of the frequency is about 0.0004
+	BOOST_CHECK_SMALL( static_cast<double>(ones) / sample_size - 0.75, 0.003 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -111,6 +111,50 @@ uint64_t time_engine_TSC(Engine & e, CounterType iterations)
 	return end - start;
 }
 
+// bulk generation into a buffer, for engines with a generate member
+template<typename Engine>
+inline
+auto generate_block(Engine & e, typename Engine::result_type * dest, size_t num, int) 
+	-> decltype( e.generate(dest, num), void() )
+{
+	e.generate(dest, num);
+}
+
+// otherwise one number at a time
+template<typename Engine>
+inline
+void generate_block(Engine & e, typename Engine::result_type * dest, size_t num, long) 
+{
+	for (; num > 0; --num)
+		*(dest++) = e();
+}
+
+//time stamp counter, generating blocks of numbers at a time
+template<typename Engine, typename CounterType>
+inline
+uint64_t time_engine_TSC_block(Engine & e, CounterType iterations) 
+{
+	static const size_t block_size = 4096;
+	std::vector<typename Engine::result_type> block(block_size);
+	volatile typename Engine::result_type value;
+
+    timer_type timer;
+
+	uint64_t start = timer();
+
+	while (iterations > 0)
+	{
+		const size_t num = iterations < block_size ? static_cast<size_t>(iterations) : block_size;
+		generate_block(e, &block[0], num, 0);
+		value = block[num - 1];
+		iterations -= num;
+	}
+
+	uint64_t end = timer();
+
+	return end - start;
+}
+
 #define TIMER_MACRO_TSC(Engine, e, iter, result)\
 	volatile typename Engine::result_type value;\
 												\
@@ -184,6 +228,8 @@ namespace detail {
 	typedef mpl::string<'m','a','c','r','o'>::type macro_string;
 	typedef qfcl::tmp::concatenate<rdtsc_string, mpl::string<'_'>::type, macro_string>::type rdtsc_macro_string;
 	typedef mpl::string<'b','o','o','s','t'>::type boost_string;
+	typedef mpl::string<'b','l','o','c','k'>::type block_string;
+	typedef qfcl::tmp::concatenate<rdtsc_string, mpl::string<'_'>::type, block_string>::type rdtsc_block_string;
 }	// namespace detail
 
 struct boost_timer
@@ -245,8 +291,27 @@ struct rdtsc_macro
 	typedef detail::rdtsc_macro_string name;
 };
 
+struct rdtsc_block
+{
+	typedef uint64_t result_type;
+
+	template<typename Engine, typename CounterType>
+	result_type operator()(Engine &, CounterType iterations) const
+	{
+		Engine e;
+		return time_engine_TSC_block(e, iterations); 
+	}
+
+	static string description()
+	{
+		return "time stamp counter (non-serialized), generating blocks of 4096 numbers with generate() where available";
+	}
+
+	typedef detail::rdtsc_block_string name;
+};
+
 // list of timers
-typedef mpl::vector<rdtsc, rdtsc_macro, boost_timer> timer_list;
+typedef mpl::vector<rdtsc, rdtsc_macro, rdtsc_block, boost_timer> timer_list;
 
 // We want to avoid double type-selection for now, so we use the following "kludge".
 template<typename EngineList, typename CounterType, typename SelectionMethod>
@@ -262,6 +327,11 @@ void perform_speed_test(const vector<string> & engine_params, const string & tim
 			engine_params, 
 			timer_object<CounterType, rdtsc_macro>(iterations, cpu_freq)
 		);
+	else if (timer_name == "rdtsc_block")
+        qfcl::type_selection::for_each_selector<EngineList, SelectionMethod>(
+			engine_params, 
+			timer_object<CounterType, rdtsc_block>(iterations, cpu_freq)
+		);
 	else if (timer_name == "boost")
         qfcl::type_selection::for_each_selector<EngineList, SelectionMethod>(
 			engine_params, 
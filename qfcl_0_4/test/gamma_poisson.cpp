@@ -0,0 +1,178 @@
+/* test/gamma_poisson.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <qfcl/random/distribution/chi_squared.hpp>
+#include <qfcl/random/distribution/gamma.hpp>
+#include <qfcl/random/distribution/poisson.hpp>
+#include <qfcl/random/engine/mersenne_twister.hpp>
+
+namespace {
+
+const std::size_t sample_size = 400000;
+
+//! the sample mean and variance of \p x
+template<typename T>
+void moments(const std::vector<T> & x, double & mean, double & variance)
+{
+	mean = variance = 0;
+	for (std::size_t i = 0; i < x.size(); ++i)
+		mean += x[i];
+	mean /= x.size();
+
+	for (std::size_t i = 0; i < x.size(); ++i)
+		variance += (x[i] - mean) * (x[i] - mean);
+	variance /= x.size() - 1;
+}
+
+//! the mean and variance of \p n variates of \p Distribution are within 4 standard errors of \p mean and \p variance
+template<class Distribution>
+void check_moments(const Distribution & d, double expected_mean, double expected_variance, double kurtosis_bound)
+{
+	using namespace qfcl::random;
+
+	mt19937 eng;
+	variate_generator<mt19937 &, Distribution> rng(eng, d);
+	std::vector<typename Distribution::result_type> x(sample_size);
+	rng.generate( x.begin(), x.size() );
+
+	double mean, variance;
+	moments(x, mean, variance);
+
+	BOOST_CHECK_SMALL( mean - expected_mean, 4 * std::sqrt(expected_variance / sample_size) );
+	BOOST_CHECK_SMALL( variance - expected_variance, 4 * expected_variance * std::sqrt(kurtosis_bound / sample_size) );
+}
+
+}	// anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(gamma_poisson)
+
+//! the gamma variates have the right mean and variance, for shapes below and above 1
+BOOST_AUTO_TEST_CASE(gamma)
+{
+	BOOST_TEST_MESSAGE("Testing gamma_distribution ...");
+
+	const double shapes[] = {0.05, 0.3, 1, 2.5, 30};
+	for (std::size_t i = 0; i < sizeof(shapes) / sizeof(shapes[0]); ++i)
+	{
+		const double alpha = shapes[i], beta = 1.5;
+		check_moments( qfcl::random::gamma_distribution<>(alpha, beta), alpha * beta, alpha * beta * beta, 2 + 6 / alpha );
+	}
+
+	// positive even for a tiny shape, in single precision
+	qfcl::random::mt19937 eng;
+	qfcl::random::variate_generator<qfcl::random::mt19937 &, qfcl::random::gamma_distribution<float> > rng( eng, qfcl::random::gamma_distribution<float>(0.5f) );
+	for (std::size_t i = 0; i < 10000; ++i)
+		BOOST_REQUIRE( rng() >= 0 );
+}
+
+//! the Poisson variates have the right mean and variance, for means on both sides of the switch to PTRS
+BOOST_AUTO_TEST_CASE(poisson)
+{
+	BOOST_TEST_MESSAGE("Testing poisson_distribution ...");
+
+	const double means[] = {0.01, 0.5, 3, 9.99, 10, 50, 1000};
+	for (std::size_t i = 0; i < sizeof(means) / sizeof(means[0]); ++i)
+		check_moments( qfcl::random::poisson_distribution<>(means[i]), means[i], means[i], 2 + 1 / means[i] );
+}
+
+//! the frequencies of the tabulated inversion and of PTRS agree with the probabilities
+BOOST_AUTO_TEST_CASE(poisson_frequencies)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the frequencies of poisson_distribution ...");
+
+	const double means[] = {4, 25};
+	for (std::size_t m = 0; m < 2; ++m)
+	{
+		const double lambda = means[m];
+		mt19937 eng;
+		variate_generator<mt19937 &, poisson_distribution<> > rng( eng, poisson_distribution<>(lambda) );
+
+		std::vector<double> count(100);
+		for (std::size_t i = 0; i < sample_size; ++i)
+		{
+			const int k = rng();
+			BOOST_REQUIRE( 0 <= k );
+			if (k < 100)
+				++count[k];
+		}
+
+		for (int k = 0; k < 60; ++k)
+		{
+			const double p = std::exp( -lambda + k * std::log(lambda) - detail::log_factorial(k) );
+			if (p * sample_size > 100)
+				BOOST_CHECK_SMALL( count[k] / sample_size - p, 5 * std::sqrt(p / sample_size) );
+		}
+	}
+
+	// log k! by the table and by Stirling's series
+	BOOST_CHECK_CLOSE( detail::log_factorial(255), std::lgamma(256.0), 1e-12 );
+	BOOST_CHECK_CLOSE( detail::log_factorial(256), std::lgamma(257.0), 1e-12 );
+	BOOST_CHECK_CLOSE( detail::log_factorial(10000), std::lgamma(10001.0), 1e-12 );
+
+	// a mean for each variate
+	mt19937 eng;
+	variate_generator<mt19937 &, poisson_distribution<> > rng( eng, poisson_distribution<>() );
+	std::vector<double> lambda(sample_size);
+	std::vector<int> k(sample_size);
+	for (std::size_t i = 0; i < sample_size; ++i)
+		lambda[i] = i % 2 ? 2 : 40;
+	rng.generate( &lambda[0], &k[0], sample_size );
+
+	double sum_2 = 0, sum_40 = 0;
+	for (std::size_t i = 0; i < sample_size; ++i)
+		(i % 2 ? sum_2 : sum_40) += k[i];
+	BOOST_CHECK_CLOSE( sum_2 / (sample_size / 2), 2.0, 1.0 );
+	BOOST_CHECK_CLOSE( sum_40 / (sample_size / 2), 40.0, 0.5 );
+}
+
+//! the chi-squared variates have the right means and variances, with fewer and more than one degree of freedom
+BOOST_AUTO_TEST_CASE(chi_squared)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the chi-squared distributions ...");
+
+	check_moments( chi_squared_distribution<>(3), 3, 6, 2 + 12 / 3.0 );
+	check_moments( chi_squared_distribution<>(0.4), 0.4, 0.8, 2 + 12 / 0.4 );
+
+	const double dof[] = {0.3, 1, 4.5};
+	for (std::size_t i = 0; i < 3; ++i)
+	{
+		const double k = dof[i], lambda = 2.5;
+		check_moments( noncentral_chi_squared_distribution<>(k, lambda), k + lambda, 2 * (k + 2 * lambda), 2 + 12 / k );
+	}
+
+	// a noncentrality for each variate, as for the CIR process
+	for (std::size_t i = 0; i < 3; ++i)
+	{
+		const double k = dof[i];
+		mt19937 eng;
+		variate_generator<mt19937 &, noncentral_chi_squared_distribution<> > rng( eng, noncentral_chi_squared_distribution<>(k, 0) );
+
+		std::vector<double> lambda(sample_size), x(sample_size);
+		for (std::size_t j = 0; j < sample_size; ++j)
+			lambda[j] = j % 2 ? 1 : 5;
+		rng.generate( &lambda[0], &x[0], sample_size );
+
+		double mean, variance;
+		moments(x, mean, variance);
+		BOOST_CHECK_CLOSE( mean, k + 3, 1.0 );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,274 @@
+/* test/gbm.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <qfcl/random/distribution/correlated_gbm_at_fixed_time.hpp>
+#include <qfcl/random/distribution/gbm_npv_vanilla_call.hpp>
+#include <qfcl/random/engine/mersenne_twister.hpp>
+#include <qfcl/utility/simd.hpp>
+
+namespace {
+
+//! the normals -8, ..., 8, with a remainder after the last full SIMD vector
+std::vector<double> test_normals()
+{
+	std::vector<double> z;
+	for (double x = -8; x <= 8; x += 0.0123)
+		z.push_back(x);
+
+	return z;
+}
+
+//! the Black-Scholes price of a call on an asset with continuous dividend yield \p q
+double black_scholes_call(double S0, double vol, double q, double r, double K, double t)
+{
+	const double s = vol * std::sqrt(t);
+	const double d1 = ( std::log(S0 / K) + (r - q) * t ) / s + s / 2;
+	const double N1 = std::erfc( -d1 / std::sqrt(2.0) ) / 2, N2 = std::erfc( -(d1 - s) / std::sqrt(2.0) ) / 2;
+
+	return S0 * std::exp(-q * t) * N1 - K * std::exp(-r * t) * N2;
+}
+
+}	// anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(gbm)
+
+#if defined(QFCL_SIMD_SSE2)
+//! the vectorized exponential is accurate to a few ulps, in double and single precision
+BOOST_AUTO_TEST_CASE(simd_exp)
+{
+	BOOST_TEST_MESSAGE("Testing the vectorized exp ...");
+
+	typedef qfcl::simd::real_ops<double>::type double_ops;
+	typedef qfcl::simd::real_ops<float>::type float_ops;
+
+	double xd[8];
+	float xf[16];
+	for (double x = -700; x < 700; x += 0.731)
+	{
+		std::fill(xd, xd + 8, x);
+		std::fill(xf, xf + 16, static_cast<float>(x / 10));
+
+		double_ops::store( xd, qfcl::simd::exp<double_ops>( double_ops::load(xd) ) );
+		float_ops::store( xf, qfcl::simd::exp<float_ops>( float_ops::load(xf) ) );
+
+		BOOST_REQUIRE_CLOSE( xd[0], std::exp(x), 1e-13 );
+		BOOST_REQUIRE_CLOSE( xf[0], std::exp( static_cast<double>( static_cast<float>(x / 10) ) ), 1e-5 );
+	}
+}
+#endif
+
+//! the batch payoffs agree with the payoff of a single normal, and the antithetic ones are averages of two
+BOOST_AUTO_TEST_CASE(batch_payoffs)
+{
+	BOOST_TEST_MESSAGE("Testing the batch payoffs of gbm_vanilla_call ...");
+
+	const qfcl::random::gbm_vanilla_call call(100, 0.3, 0.01, 0.05, 110, 2);
+	const double forward = 100 * std::exp( (0.01 - 0.05 - 0.045) * 2 ), npv_strike = 110 * std::exp(-0.05 * 2);
+	const double diffusion = 0.3 * std::sqrt(2.0);
+
+	const std::vector<double> z = test_normals();
+	std::vector<double> payoffs( z.size() ), antithetic( z.size() );
+	call.payoffs( &z[0], &payoffs[0], z.size() );
+	call.antithetic_payoffs( &z[0], &antithetic[0], z.size() );
+
+	for (std::size_t i = 0; i < z.size(); ++i)
+	{
+		const double up = std::max( forward * std::exp(diffusion * z[i]) - npv_strike, 0.0 );
+		const double down = std::max( forward * std::exp(-diffusion * z[i]) - npv_strike, 0.0 );
+
+		BOOST_CHECK_SMALL( payoffs[i] - up, 1e-12 * std::max(1.0, up) );
+		BOOST_CHECK_SMALL( antithetic[i] - (up + down) / 2, 1e-12 * std::max(1.0, up + down) );
+	}
+
+	// in place
+	std::vector<double> w(z);
+	call.payoffs( &w[0], &w[0], w.size() );
+	BOOST_CHECK( w == payoffs );
+}
+
+//! the sampled payoffs are those of the normals from the engine, and their means converge to the Black-Scholes price
+BOOST_AUTO_TEST_CASE(sample)
+{
+	BOOST_TEST_MESSAGE("Testing the batch sampling of gbm_vanilla_call ...");
+
+	using qfcl::random::mt19937;
+	typedef qfcl::random::normal_inversion_distribution<> normal;
+
+	// the asset grows at the risk free rate
+	const qfcl::random::gbm_vanilla_call call(100, 0.2, 0.05, 0.05, 100, 1);
+	const std::size_t n = 1000000;
+
+	mt19937 eng, copy;
+	std::vector<double> payoffs(n), antithetic(n), z(5000);
+	call.sample( eng, &payoffs[0], n );
+	call.antithetic_sample( eng, &antithetic[0], n );
+
+	qfcl::random::variate_generator<mt19937 &, normal> rng( copy, normal() );
+	std::generate( z.begin(), z.end(), rng );
+	call.payoffs( &z[0], &z[0], z.size() );
+	// the block inversion of the normals may differ from the scalar one in the last bits
+	for (std::size_t i = 0; i < z.size(); ++i)
+		BOOST_REQUIRE_SMALL( payoffs[i] - z[i], 1e-6 );
+
+	double mean = 0, antithetic_mean = 0;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		mean += payoffs[i];
+		antithetic_mean += antithetic[i];
+	}
+	mean /= n;
+	antithetic_mean /= n;
+
+	const double price = black_scholes_call(100, 0.2, 0, 0.05, 100, 1);
+	BOOST_CHECK_CLOSE( mean, price, 1.0 );
+	BOOST_CHECK_CLOSE( antithetic_mean, price, 0.5 );
+}
+
+//! the correlation matrix of \p d assets with correlation \p rho between assets i and i + 1, and 0.3 otherwise
+std::vector<double> banded_correlation(std::size_t d, double rho)
+{
+	std::vector<double> c(d * d, 0.3);
+	for (std::size_t i = 0; i < d; ++i)
+	{
+		c[i * d + i] = 1;
+		if (i + 1 < d)
+			c[i * d + i + 1] = c[(i + 1) * d + i] = rho;
+	}
+
+	return c;
+}
+
+//! the terminal values are those of the Cholesky factor, for every number of assets modulo the rows done together
+BOOST_AUTO_TEST_CASE(correlated_terminal_values)
+{
+	BOOST_TEST_MESSAGE("Testing the terminal values of correlated_gbm_at_fixed_time ...");
+
+	const std::vector<double> z = test_normals();
+
+	for (std::size_t d = 1; d <= 9; ++d)
+	{
+		const std::size_t n = z.size() / d;
+		std::vector<double> S0(d), vol(d), yield(d);
+		for (std::size_t i = 0; i < d; ++i)
+		{
+			S0[i] = 100 + i;
+			vol[i] = 0.1 + 0.02 * i;
+			yield[i] = 0.01 * i;
+		}
+
+		const std::vector<double> rho = banded_correlation(d, 0.5);
+		const qfcl::random::correlated_gbm_at_fixed_time gbm(S0, vol, yield, rho, 2);
+		BOOST_CHECK( !gbm.repaired() );
+
+		std::vector<double> L(rho);
+		BOOST_REQUIRE( qfcl::random::detail::cholesky(L, d) );
+
+		std::vector<double> S(d * n);
+		gbm.terminal_values(&z[0], &S[0], n);
+
+		for (std::size_t k = 0; k < n; ++k)
+			for (std::size_t i = 0; i < d; ++i)
+			{
+				double x = 0;
+				for (std::size_t j = 0; j <= i; ++j)
+					x += L[i * d + j] * z[j * n + k];
+
+				const double expected = S0[i] * std::exp( (yield[i] - vol[i] * vol[i] / 2) * 2 + vol[i] * std::sqrt(2.0) * x );
+				BOOST_REQUIRE_CLOSE( S[i * n + k], expected, 1e-10 );
+			}
+	}
+}
+
+//! a correlation matrix that is not positive semidefinite is replaced by a nearby one, and a singular one is factorized
+BOOST_AUTO_TEST_CASE(correlation_repair)
+{
+	BOOST_TEST_MESSAGE("Testing the repair of correlation matrices ...");
+
+	const std::vector<double> ones(3, 1.0), zeros(3, 0.0);
+
+	// assets 0 and 1 and assets 1 and 2 are highly correlated, but assets 0 and 2 are not
+	const double indefinite[] = {1, 0.9, 0.1, 0.9, 1, 0.9, 0.1, 0.9, 1};
+	const qfcl::random::correlated_gbm_at_fixed_time gbm( ones, ones, zeros, std::vector<double>(indefinite, indefinite + 9), 1 );
+	BOOST_CHECK( gbm.repaired() );
+
+	std::vector<double> a(indefinite, indefinite + 9);
+	qfcl::random::detail::repair_correlation(a, 3);
+	for (std::size_t i = 0; i < 3; ++i)
+		BOOST_CHECK_CLOSE( a[i * 3 + i], 1.0, 1e-10 );
+	BOOST_CHECK( std::fabs(a[1] - 0.9) < 0.15 && std::fabs(a[2] - 0.1) < 0.15 );
+	BOOST_CHECK( qfcl::random::detail::cholesky(a, 3) );
+
+	// perfectly correlated assets
+	const double singular[] = {1, 1, 0, 1, 1, 0, 0, 0, 1};
+	const qfcl::random::correlated_gbm_at_fixed_time twins( ones, ones, zeros, std::vector<double>(singular, singular + 9), 1 );
+	BOOST_CHECK( !twins.repaired() );
+
+	const double z[] = {0.5, -1, 2};
+	double S[3];
+	twins.terminal_values(z, S, 1);
+	BOOST_CHECK_CLOSE( S[0], S[1], 1e-12 );
+
+	BOOST_CHECK_THROW( qfcl::random::correlated_gbm_at_fixed_time( ones, ones, zeros, std::vector<double>(4, 1.0), 1 ),
+		std::invalid_argument );
+
+	// a matrix that cannot be factorized even after the repair
+	std::vector<double> not_finite(indefinite, indefinite + 9);
+	not_finite[1] = not_finite[3] = std::numeric_limits<double>::quiet_NaN();
+	std::vector<double> L(not_finite);
+	BOOST_CHECK( !qfcl::random::detail::cholesky(L, 3) );
+	BOOST_CHECK_THROW( qfcl::random::correlated_gbm_at_fixed_time( ones, ones, zeros, not_finite, 1 ),
+		std::invalid_argument );
+}
+
+//! the sampled log returns have the given correlations, and the terminal values the right means
+BOOST_AUTO_TEST_CASE(correlated_sample)
+{
+	BOOST_TEST_MESSAGE("Testing the sampling of correlated_gbm_at_fixed_time ...");
+
+	const std::size_t d = 6, n = 200000;
+	const std::vector<double> S0(d, 100.0), vol(d, 0.25), yield(d, 0.03);
+	const std::vector<double> rho = banded_correlation(d, 0.6);
+
+	const qfcl::random::correlated_gbm_at_fixed_time gbm(S0, vol, yield, rho, 1);
+	BOOST_REQUIRE( !gbm.repaired() );
+	qfcl::random::mt19937 eng;
+	std::vector<double> S(d * n);
+	gbm.sample(eng, &S[0], n);
+
+	std::vector<double> x(d * n);
+	for (std::size_t i = 0; i < d * n; ++i)
+		x[i] = ( std::log(S[i] / 100) - (0.03 - 0.25 * 0.25 / 2) ) / 0.25;
+
+	for (std::size_t i = 0; i < d; ++i)
+	{
+		double mean = 0;
+		for (std::size_t k = 0; k < n; ++k)
+			mean += S[i * n + k];
+		BOOST_CHECK_CLOSE( mean / n, 100 * std::exp(0.03), 0.5 );
+
+		for (std::size_t j = 0; j < i; ++j)
+		{
+			double c = 0;
+			for (std::size_t k = 0; k < n; ++k)
+				c += x[i * n + k] * x[j * n + k];
+			BOOST_CHECK_SMALL( c / n - rho[i * d + j], 0.01 );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
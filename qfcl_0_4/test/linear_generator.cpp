@@ -19,6 +19,7 @@
 
 #include <algorithm>
 using std::swap;
+#include <atomic>
 
 #include <iomanip>
 #include <iostream>
@@ -26,6 +27,7 @@ using std::swap;
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/bind.hpp>
@@ -341,6 +343,224 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(reverse_discard, Engine, reversible_linear_generat
 	BOOST_REQUIRE(eng1 == eng2);
 }
 
+//! Tests that jumping with the minimal polynomial agrees with the jump matrix, in both directions
+BOOST_AUTO_TEST_CASE_TEMPLATE(polynomial_jump, pair, linear_generator_engine_pairs)
+{
+	if( qfcl::tmp::is_first<linear_generator_engine_pairs, pair>::value )
+		BOOST_TEST_MESSAGE("Testing discard() and reverse_discard() using the minimal polynomial ...");
+
+	typedef pair::first Engine;
+
+	const unsigned long long discard_size = 10 * Engine::state_size;
+
+	// use default seed
+	Engine eng1, eng2;
+	
+#ifdef	QFCL_VERBOSE_TEST
+	print_engine_name(eng1, " ... this may take some time.");
+#endif	// QFCL_VERBOSE_TEST
+
+	eng1.discard(discard_size, matrix_jump);
+	eng2.discard(discard_size, polynomial_jump);
+
+	BOOST_CHECK(eng1 == eng2);
+
+	eng1.reverse_discard(2 * discard_size, matrix_jump);
+	eng2.reverse_discard(2 * discard_size, polynomial_jump);
+
+	BOOST_CHECK(eng1 == eng2);
+}
+
+//! Tests that alternating between jump sizes is served from the \c jump_matrix_cache
+BOOST_AUTO_TEST_CASE(jump_matrix_cache)
+{
+	BOOST_TEST_MESSAGE("Testing the jump matrix cache using " << mpl::c_str<tt800::name>::value << " ...");
+
+	qfcl::random::jump_matrix_cache & cache = qfcl::random::jump_matrix_cache::instance();
+	cache.clear();
+	cache.reset_statistics();
+
+	const unsigned long long jump_sizes[] = {1000, 2000, 3000};
+	const size_t rounds = 3;
+
+	tt800 eng;
+	for (size_t i = 0; i < rounds; ++i)
+		BOOST_FOREACH(unsigned long long v, jump_sizes)
+			eng.discard(v, matrix_jump);
+
+	// each jump matrix is only obtained once
+	BOOST_CHECK_EQUAL( cache.misses(), 3u );
+	BOOST_CHECK_EQUAL( cache.hits(), 3u * (rounds - 1) );
+	BOOST_CHECK_EQUAL( cache.count(), 3u );
+
+	// shrinking the capacity evicts the least recently used
+	const size_t matrix_bytes = cache.size() / 3;
+	cache.capacity(2 * matrix_bytes);
+	BOOST_CHECK_EQUAL( cache.count(), 2u );
+
+	tt800::JumpMatrix(jump_sizes[0]);
+	BOOST_CHECK_EQUAL( cache.misses(), 4u );
+
+	cache.capacity(qfcl::random::jump_matrix_cache::default_capacity);
+}
+
+//! Tests that threads missing on the same key at once compute the matrix only once
+BOOST_AUTO_TEST_CASE(jump_matrix_cache_concurrent_misses)
+{
+	BOOST_TEST_MESSAGE("Testing concurrent misses on the jump matrix cache ...");
+
+	typedef qfcl::random::jump_matrix_cache cache_t;
+
+	cache_t cache;
+	const cache_t::key_type key("test", 1000, false);
+	const size_t thread_count = 8;
+
+	std::atomic<int> computed(0);
+	std::atomic<bool> fail(true);
+	auto compute = [&] () -> cache_t::matrix_t {
+		++computed;
+		// A thread counts its miss under the lock, in the same step as it finds the pending computation,
+		// so once every thread has missed they are all waiting on this one.
+		while ( cache.misses() < thread_count )
+			std::this_thread::yield();
+		if (fail)
+			throw std::runtime_error("compute failed");
+		NTL::mat_GF2 M;
+		NTL::ident(M, 64);
+		return M;
+	};
+
+	// every waiting thread gets the exception, and nothing is cached
+	cache.reset_statistics();
+	std::atomic<int> failures(0);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < thread_count; ++i)
+		threads.push_back( std::thread( [&] () {
+			try
+			{
+				cache.get(key, compute);
+			}
+			catch (const std::runtime_error &)
+			{
+				++failures;
+			}
+		} ) );
+	for (size_t i = 0; i < thread_count; ++i)
+		threads[i].join();
+
+	BOOST_CHECK_EQUAL( computed, 1 );
+	BOOST_CHECK_EQUAL( failures, static_cast<int>(thread_count) );
+	BOOST_CHECK_EQUAL( cache.count(), 0u );
+
+	fail = false;
+	computed = 0;
+	cache.reset_statistics();
+	std::vector<cache_t::matrix_ptr> results(thread_count);
+	threads.clear();
+	for (size_t i = 0; i < thread_count; ++i)
+		threads.push_back( std::thread( [&, i] () {results[i] = cache.get(key, compute);} ) );
+	for (size_t i = 0; i < thread_count; ++i)
+		threads[i].join();
+
+	BOOST_CHECK_EQUAL( computed, 1 );
+	BOOST_CHECK_EQUAL( cache.count(), 1u );
+	for (size_t i = 0; i < thread_count; ++i)
+		BOOST_CHECK( results[i] == results[0] );
+}
+
+//! Tests that generating in bulk agrees with generating one number at a time
+BOOST_AUTO_TEST_CASE_TEMPLATE(generate, pair, linear_generator_engine_pairs)
+{
+	if( qfcl::tmp::is_first<linear_generator_engine_pairs, pair>::value )
+		BOOST_TEST_MESSAGE("Testing generate() ...");
+
+	typedef pair::first Engine;
+	typedef typename Engine::result_type result_t;
+
+	// use default seed
+	Engine eng1, eng2;
+	
+#ifdef	QFCL_VERBOSE_TEST
+	print_engine_name(eng1, " ...");
+#endif	// QFCL_VERBOSE_TEST
+
+	// requests shorter than, equal to and spanning several state blocks, 
+	// starting at various positions within the block
+	const size_t sizes[] = {1, 7, Engine::state_size - 1, Engine::state_size, 3 * Engine::state_size + 5, 0, 2};
+
+	BOOST_FOREACH(size_t size, sizes)
+	{
+		std::vector<result_t> expected(size), actual(size + 1);
+
+		for (size_t i = 0; i < size; ++i)
+			expected[i] = eng1();
+
+		BOOST_CHECK( eng2.generate(actual.begin(), size) == actual.begin() + size );
+		actual.pop_back();
+		BOOST_CHECK( expected == actual );
+		BOOST_CHECK(eng1 == eng2);
+	}
+
+	std::vector<result_t> expected(100), actual(100);
+	for (size_t i = 0; i < expected.size(); ++i)
+		expected[i] = eng1();
+	eng2.fill( actual.begin(), actual.end() );
+	BOOST_CHECK( expected == actual );
+	BOOST_CHECK(eng1 == eng2);
+}
+
+//! Tests that reverse_generate agrees with reverse(), and that the reverse_adapter generates in the other direction
+BOOST_AUTO_TEST_CASE_TEMPLATE(reverse_generate, pair, linear_generator_engine_pairs)
+{
+	if( qfcl::tmp::is_first<linear_generator_engine_pairs, pair>::value )
+		BOOST_TEST_MESSAGE("Testing reverse_generate() ...");
+
+	typedef pair::first Engine;
+	typedef pair::second reverseEngine;
+	typedef typename Engine::result_type result_t;
+
+	// use default seed
+	Engine eng1, eng2, eng3;
+	
+#ifdef	QFCL_VERBOSE_TEST
+	print_engine_name(eng1, " ...");
+#endif	// QFCL_VERBOSE_TEST
+
+	// move away from the seed, so that the reversal crosses several state blocks
+	eng1.discard(10 * Engine::state_size);
+	eng2.discard(10 * Engine::state_size);
+	eng3.discard(10 * Engine::state_size);
+
+	const size_t sizes[] = {1, 7, Engine::state_size - 1, Engine::state_size, 3 * Engine::state_size + 5, 0, 2};
+
+	BOOST_FOREACH(size_t size, sizes)
+	{
+		std::vector<result_t> expected(size), actual(size), to_array(size + 1);
+
+		for (size_t i = 0; i < size; ++i)
+			expected[i] = eng1.reverse();
+
+		BOOST_CHECK( eng2.reverse_generate(actual.begin(), size) == actual.end() );
+		BOOST_CHECK( expected == actual );
+		BOOST_CHECK(eng1 == eng2);
+
+		// writing to an array, which engines may handle separately (see mersenne_twister_engine::ReverseTransform_n)
+		result_t * const first = &to_array[0];
+		BOOST_CHECK( eng3.reverse_generate(first, size) == first + size );
+		BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(), first, first + size );
+		BOOST_CHECK(eng1 == eng3);
+	}
+
+	// the reverse_adapter generates the original sequence backwards
+	Engine eng;
+	std::vector<result_t> forward(2 * Engine::state_size + 3), backward( forward.size() );
+	eng.generate( forward.begin(), forward.size() );
+
+	reverseEngine reverse_eng(eng);
+	reverse_eng.fill( backward.begin(), backward.end() );
+	BOOST_CHECK_EQUAL_COLLECTIONS( forward.rbegin(), forward.rend(), backward.begin(), backward.end() );
+}
+
 //! Tests peek
 BOOST_AUTO_TEST_CASE_TEMPLATE(peek, Engine, all_linear_generator_engines)
 {
@@ -0,0 +1,247 @@
+/* test/matrix.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+/*! \file test/matrix.cpp
+	\brief unit tests for the matrices used by linear generators
+
+	\author agent
+	\date October 17, 2026
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <boost/foreach.hpp>
+
+#include <qfcl/random/engine/matrix.hpp>
+using namespace qfcl::random;
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+/*! \ingroup TestSuite
+	@{
+*/
+
+BOOST_AUTO_TEST_SUITE(matrix)
+
+//! a random \f$\mathbb F_2\f$ matrix, with a number of columns that is not a multiple of the word size
+Matrix<2> random_matrix(long rows = 300, long cols = 217)
+{
+	Matrix<2> M;
+	M.SetDims(rows, cols);
+	for (long i = 0; i < rows; ++i)
+		NTL::random(M[i], cols);
+
+	return M;
+}
+
+//! write a matrix and read it back
+BOOST_AUTO_TEST_CASE(file_round_trip)
+{
+	BOOST_TEST_MESSAGE("Testing the matrix file format ...");
+
+	const std::string filename = "matrix_test.Matrix";
+	const Matrix<2> M = random_matrix();
+
+	M.write(filename, "test");
+
+	Matrix<2> N;
+	BOOST_REQUIRE( N.read(filename) );
+	BOOST_CHECK(M == N);
+
+	// the file is also usable without reading it into memory
+	BOOST_REQUIRE( mapped_matrix::is_mappable(filename) );
+	mapped_matrix mapped(filename, true);
+	BOOST_CHECK_EQUAL( mapped.NumRows(), M.NumRows() );
+	BOOST_CHECK_EQUAL( mapped.NumCols(), M.NumCols() );
+	BOOST_CHECK_EQUAL( mapped.engine_name(), "test" );
+
+	std::remove( filename.c_str() );
+
+	BOOST_CHECK( !N.read(filename) );
+}
+
+//! files in the original unversioned format can still be read
+BOOST_AUTO_TEST_CASE(legacy_file)
+{
+	BOOST_TEST_MESSAGE("Testing reading the original matrix file format ...");
+
+	const std::string filename = "matrix_test_legacy.Matrix";
+	const Matrix<2> M = random_matrix();
+
+	{
+		std::ofstream ofs( filename.c_str(), std::ios::binary );
+		long rows = M.NumRows(), cols = M.NumCols();
+		ofs.write( reinterpret_cast<const char *>(&rows), sizeof(rows) );
+		ofs.write( reinterpret_cast<const char *>(&cols), sizeof(cols) );
+		for (long i = 0; i < rows; ++i)
+			ofs.write( reinterpret_cast<const char *>(M[i].rep.rep), M[i].rep.length() * sizeof(_ntl_ulong) );
+	}
+
+	Matrix<2> N;
+	BOOST_REQUIRE( N.read(filename) );
+	BOOST_CHECK(M == N);
+	BOOST_CHECK( !mapped_matrix::is_mappable(filename) );
+
+	std::remove( filename.c_str() );
+}
+
+//! a header claiming more rows than the file holds is rejected, even when the size in bytes would overflow
+BOOST_AUTO_TEST_CASE(corrupt_header)
+{
+	BOOST_TEST_MESSAGE("Testing a matrix file with a corrupt header ...");
+
+	const std::string filename = "matrix_test_corrupt.Matrix";
+	random_matrix().write(filename);
+
+	detail::matrix_file_header header;
+	{
+		std::ifstream ifs( filename.c_str(), std::ios::binary );
+		ifs.read( reinterpret_cast<char *>(&header), sizeof(header) );
+	}
+
+	// for the second, rows * row_stride * sizeof(word) wraps around to less than the size of two rows
+	const boost::uint64_t rows[] = { header.rows + 1, (~boost::uint64_t(0) / (header.row_stride * sizeof(_ntl_ulong))) + 2 };
+	BOOST_FOREACH(boost::uint64_t r, rows)
+	{
+		header.rows = r;
+		{
+			std::fstream fs( filename.c_str(), std::ios::binary | std::ios::in | std::ios::out );
+			fs.write( reinterpret_cast<const char *>(&header), sizeof(header) );
+		}
+
+		BOOST_CHECK_THROW( mapped_matrix mapped(filename), std::runtime_error );
+		Matrix<2> N;
+		BOOST_CHECK_THROW( N.read(filename), std::runtime_error );
+	}
+
+	std::remove( filename.c_str() );
+}
+
+//! the memory mapped matrix-vector product agrees with NTL
+BOOST_AUTO_TEST_CASE(mapped_product)
+{
+	BOOST_TEST_MESSAGE("Testing the memory mapped matrix-vector product ...");
+
+	const std::string filename = "matrix_test_mapped.Matrix";
+	const Matrix<2> M = random_matrix();
+	M.write(filename);
+
+	{
+		mapped_matrix mapped(filename);
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			NTL::vec_GF2 v;
+			NTL::random( v, M.NumCols() );
+
+			BOOST_CHECK( mapped * v == M * v );
+		}
+	}
+
+	std::remove( filename.c_str() );
+}
+
+//! the Four Russians product agrees with NTL
+BOOST_AUTO_TEST_CASE(m4rm_product)
+{
+	BOOST_TEST_MESSAGE("Testing the Method of Four Russians matrix product ...");
+
+	// dimensions that are not multiples of the word size or of the table size
+	const Matrix<2> A = random_matrix(300, 217), B = random_matrix(217, 1003);
+
+	NTL::mat_GF2 expected;
+	NTL::mul( expected, static_cast<const NTL::mat_GF2 &>(A), static_cast<const NTL::mat_GF2 &>(B) );
+
+	BOOST_CHECK( A * B == expected );
+
+	// aliased, as used by pow
+	Matrix<2> C = random_matrix(217, 217);
+	NTL::mat_GF2 C_squared;
+	NTL::sqr( C_squared, static_cast<const NTL::mat_GF2 &>(C) );
+	C *= C;
+	BOOST_CHECK( C == C_squared );
+
+	BOOST_CHECK( qfcl::random::detail::pow( A * B, 0 ) == NTL::ident_mat_GF2(300) );
+	BOOST_CHECK( qfcl::random::detail::pow( Matrix<2>(C_squared), 5 ) 
+		== NTL::power( C_squared, 5 ) );
+}
+
+//! the product is the same however the rows are divided among threads
+BOOST_AUTO_TEST_CASE(threaded_product)
+{
+	BOOST_TEST_MESSAGE("Testing the multi-threaded matrix product ...");
+
+	const unsigned threads = Matrix<2>::threads();
+	BOOST_CHECK( threads > 0 );
+
+	const Matrix<2> A = random_matrix(1100, 517), B = random_matrix(517, 300);
+
+	Matrix<2>::threads(1);
+	const Matrix<2> expected = A * B;
+
+	const unsigned thread_counts[] = {2, 3, 7};
+	BOOST_FOREACH(unsigned n, thread_counts)
+	{
+		Matrix<2>::threads(n);
+		BOOST_CHECK_EQUAL( Matrix<2>::threads(), n );
+		BOOST_CHECK( A * B == expected );
+	}
+
+	// restore the default
+	Matrix<2>::threads(0);
+	BOOST_CHECK_EQUAL( Matrix<2>::threads(), threads );
+}
+
+//! jump polynomials composed from the table agree with NTL, in both directions
+BOOST_AUTO_TEST_CASE(jump_polynomial_table)
+{
+	BOOST_TEST_MESSAGE("Testing the jump polynomial table ...");
+
+	// a random modulus with nonzero constant term
+	const long degree = 300;
+	NTL::GF2X p = NTL::random_GF2X(degree);
+	NTL::SetCoeff(p, degree);
+	NTL::SetCoeff(p, 0);
+
+	const qfcl::random::jump_polynomial_table table(p);
+	const NTL::GF2XModulus F(p);
+
+	const unsigned long long exponents[] = {0, 1, 2, 1000, 123456789012345ull, ~0ull};
+	BOOST_FOREACH(unsigned long long e, exponents)
+	{
+		NTL::ZZ exponent = NTL::to_ZZ( static_cast<unsigned long>(e >> 32) );
+		exponent <<= 32;
+		exponent += NTL::to_ZZ( static_cast<unsigned long>(e & 0xffffffffu) );
+
+		BOOST_CHECK( table.power(e) == NTL::PowerXMod(exponent, F) );
+		BOOST_CHECK( NTL::IsOne( NTL::MulMod( table.power(e), table.power(e, true), F ) ) );
+	}
+
+	// file round trip
+	const std::string filename = "matrix_test.JumpPolynomialTable";
+	table.write(filename, "test");
+
+	qfcl::random::jump_polynomial_table table2;
+	BOOST_REQUIRE( table2.read(filename) );
+	BOOST_CHECK( table2.modulus() == table.modulus() );
+	BOOST_FOREACH(unsigned long long e, exponents)
+	{
+		BOOST_CHECK( table2.power(e) == table.power(e) );
+		BOOST_CHECK( table2.power(e, true) == table.power(e, true) );
+	}
+
+	std::remove( filename.c_str() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//!	@}
@@ -11,7 +11,7 @@
 #include <qfcl/random/engine/mersenne_twister.hpp>
 
 const std::string usage = "Usage: matrix_power_speed [exponentsize1 exponentsize2 ...]\n";
-const std::string description = "Comparison between QFCL and NTL F_2-matrix powers.";
+const std::string description = "Comparison between QFCL (Method of Four Russians) and NTL F_2-matrix powers.";
 
 int main(int argc, char * argv[])
 {
@@ -35,25 +35,27 @@ int main(int argc, char * argv[])
     typedef qfcl::random::mt19937 Engine;
 
 	typedef NTL::mat_GF2 NTL_matrix;
+	typedef Engine::matrix_t QFCL_matrix;
 
-	NTL_matrix T;
-	T = Engine::TransitionMatrix(false);
+	const QFCL_matrix T = Engine::TransitionMatrix(false);
+
+	cout << "pow uses " << QFCL_matrix::threads() << " threads" << endl << endl;
 
 	BOOST_FOREACH(unsigned long long e, exponent_sizes)
 	{
 		cpu_timer t_power;
 
-		NTL_matrix NTL_power = NTL::power(T, e);
+		NTL_matrix NTL_power = NTL::power(static_cast<const NTL_matrix &>(T), e);
 
 		t_power.stop();
 
 		cpu_timer t_pow;
 
-		NTL_matrix NTL_pow = qfcl::random::detail::pow(T, e);
+		QFCL_matrix QFCL_pow = qfcl::random::detail::pow(T, e);
 
 		t_pow.stop();
 
-		cout << "Exponent " << e << ": " << (NTL_power == NTL_pow ? "PASSED" : "FAILED") << endl << endl;
+		cout << "Exponent " << e << ": " << (NTL_power == QFCL_pow ? "PASSED" : "FAILED") << endl << endl;
 		cout << "Time taken for NTL::power: " << t_power.format() << endl;
 		cout << "Time taken for pow: " << t_pow.format() << endl << endl;
 	}
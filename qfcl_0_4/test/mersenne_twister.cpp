@@ -45,6 +45,7 @@ using std::swap;
 #include <qfcl/defines.hpp>
 #include <qfcl/utility/names.hpp>
 #include <qfcl/utility/tmp.hpp>
+#include <qfcl/random/engine/interleaved_mersenne_twister.hpp>
 #include <qfcl/random/engine/mersenne_twister.hpp>
 using namespace qfcl::random;
 
@@ -132,6 +133,33 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(boostRegression, pair, boost_regression)
 	}
 }
 
+//! Regression against boost of the block generation, which uses the SIMD twist and tempering where available
+BOOST_AUTO_TEST_CASE_TEMPLATE(boostRegressionGenerate, pair, boost_regression)
+{	
+	const unsigned initial_seed = 1234;
+	const size_t testSize = 100000;
+
+	BOOST_TEST_MESSAGE("Regressing QFCL's " << mpl::c_str<pair::first::name>::value 
+		<< " generate() against boost with seed " << initial_seed << " for " << testSize << " variates ...");
+	pair::first qfclMT(initial_seed);
+	pair::second boostMT(initial_seed);
+
+	// an odd block size, so that the blocks start at various positions in the state
+	std::vector<typename pair::first::result_type> block(1001);
+
+	for (size_t i = 0; i < testSize; i += block.size())
+	{
+		qfclMT.generate( &block[0], block.size() );
+
+		for (size_t j = 0; j < block.size(); ++j)
+		{
+			pair::second::result_type boost_result = boostMT();
+			BOOST_REQUIRE_MESSAGE( block[j] == boost_result, "critical check qfclMT.generate() == boostMT() [" 
+				<< block[j] << " != " << boost_result << "] failed at iteration " << i + j);
+		}
+	}
+}
+
 /*! \brief Tests mt19937 initialized with multiple seeds against the output provided
 	by the authors of MT.
 */
@@ -689,6 +717,56 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(ctor_seed, Engine, mersenne_twister_engines)
 	BOOST_CHECK(mt4 == mtSeed);
 }
 
+//! interleaved streams, including a number of streams that is not a multiple of the SIMD width
+typedef mpl::list< interleaved_mersenne_twister<mt19937, 8>,
+				   interleaved_mersenne_twister<mt19937, 3>,
+				   interleaved_mersenne_twister<mt19937_64, 4> >
+interleaved_engines;
+
+//! Tests that each interleaved stream agrees with an engine jumped ahead by discard
+BOOST_AUTO_TEST_CASE_TEMPLATE(interleaved, Interleaved, interleaved_engines)
+{
+	if( qfcl::tmp::is_first<interleaved_engines, Interleaved>::value )
+		BOOST_TEST_MESSAGE("Testing interleaved_mersenne_twister ...");
+
+	typedef typename Interleaved::engine_type Engine;
+	const size_t W = Interleaved::streams;
+	const unsigned long long spacing = 1ull << 40;
+
+	Interleaved engines(1234u, spacing);
+
+	std::vector<Engine> streams;
+	Engine e(1234u);
+	for (size_t l = 0; l < W; ++l)
+	{
+		if (l > 0)
+			e.discard(spacing);
+		streams.push_back(e);
+	}
+
+	// steps within a state block, and spanning several blocks
+	const size_t steps[] = {1, 5 * Engine::state_size + 3, 100};
+	BOOST_FOREACH(size_t step, steps)
+	{
+		std::vector<typename Engine::result_type> numbers(step * W);
+		engines.generate(numbers.begin(), step);
+
+		for (size_t s = 0; s < step; ++s)
+			for (size_t l = 0; l < W; ++l)
+				BOOST_REQUIRE_EQUAL( numbers[s * W + l], streams[l]() );
+
+		for (size_t l = 0; l < W; ++l)
+			BOOST_CHECK( engines.lane(l) == streams[l] );
+	}
+
+	engines.discard(1000000);
+	for (size_t l = 0; l < W; ++l)
+	{
+		streams[l].discard(1000000);
+		BOOST_CHECK( engines.lane(l) == streams[l] );
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 //!	@}
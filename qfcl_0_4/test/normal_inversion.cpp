@@ -0,0 +1,168 @@
+/* test/normal_inversion.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <qfcl/random/distribution/gbm_npv_vanilla_call.hpp>
+#include <qfcl/random/distribution/normal_inversion.hpp>
+#include <qfcl/random/engine/mersenne_twister.hpp>
+
+namespace {
+
+//! probabilities covering both tails, the boundaries P_LOW and P_HIGH and the center
+std::vector<double> test_probabilities()
+{
+	std::vector<double> u;
+
+	for (double p = 1e-300; p < 0.02; p *= 3.7)
+	{
+		u.push_back(p);
+		// 1 - p must be less than 1
+		if (p > 1e-16)
+			u.push_back(1 - p);
+	}
+	for (int i = 1; i < 1000; ++i)
+		u.push_back(i / 1000.0);
+	u.push_back(0.02425);
+	u.push_back(0.97575);
+	// above 1 - 2^-25, which rounds to 1 in single precision
+	u.push_back(1 - 1e-10);
+	u.push_back(1 - 2e-8);
+	u.push_back( 1 - std::ldexp(1.0, -33) );
+
+	return u;
+}
+
+}	// anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(normal_inversion)
+
+//! the batch inversion agrees with the scalar one, for every length of remainder after the last full vector
+BOOST_AUTO_TEST_CASE(batch_double)
+{
+	BOOST_TEST_MESSAGE("Testing the batch normal_inv in double precision ...");
+
+	const std::vector<double> u = test_probabilities();
+
+	for (std::size_t n = u.size() - 17; n <= u.size(); ++n)
+	{
+		std::vector<double> z(n);
+		qfcl::random::detail::normal_inv(&u[0], &z[0], n);
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const double expected = qfcl::random::detail::normal_inv(u[i]);
+			// the two sides of a boundary may be approximated differently
+			BOOST_CHECK_SMALL( (z[i] - expected) / std::max( 1.0, std::fabs(expected) ), 1e-8 );
+		}
+	}
+
+	// in place
+	std::vector<double> z(u), expected(u.size());
+	qfcl::random::detail::normal_inv(&z[0], &z[0], z.size());
+	qfcl::random::detail::normal_inv(&u[0], &expected[0], u.size());
+	BOOST_CHECK( z == expected );
+}
+
+//! the single precision batch inversion is within 5e-7 of the double precision one
+BOOST_AUTO_TEST_CASE(batch_float)
+{
+	BOOST_TEST_MESSAGE("Testing the batch normal_inv in single precision ...");
+
+	std::vector<float> u;
+	for (float p = 1e-37f; p < 0.02f; p *= 3.7f)
+	{
+		u.push_back(p);
+		if (p > 1e-7f)
+			u.push_back(1 - p);
+	}
+	for (int i = 1; i < 1000; ++i)
+		u.push_back(i / 1000.0f);
+
+	std::vector<float> z( u.size() );
+	qfcl::random::detail::normal_inv( &u[0], &z[0], u.size() );
+
+	for (std::size_t i = 0; i < u.size(); ++i)
+	{
+		const double expected = qfcl::random::detail::normal_inv( static_cast<double>(u[i]) );
+		BOOST_CHECK_SMALL( (z[i] - expected) / std::max( 1.0, std::fabs(expected) ), 5e-7 );
+	}
+}
+
+//! each accuracy tier is within its error bound of AS241, in both its scalar and batch forms
+BOOST_AUTO_TEST_CASE(accuracy_tiers)
+{
+	BOOST_TEST_MESSAGE("Testing the accuracy tiers of normal_inv ...");
+
+	namespace inversion = qfcl::random::inversion;
+	using qfcl::random::detail::normal_inv;
+
+	const std::vector<double> u = test_probabilities();
+	std::vector<double> acklam( u.size() ), as241( u.size() ), fast( u.size() );
+	normal_inv( &u[0], &acklam[0], u.size(), inversion::acklam() );
+	normal_inv( &u[0], &as241[0], u.size(), inversion::as241() );
+	normal_inv( &u[0], &fast[0], u.size(), inversion::fast() );
+
+	for (std::size_t i = 0; i < u.size(); ++i)
+	{
+		const double exact = normal_inv( u[i], inversion::as241() );
+		const double scale = std::max( 1.0, std::fabs(exact) );
+
+		BOOST_CHECK_SMALL( (as241[i] - exact) / scale, 1e-14 );
+		BOOST_CHECK_SMALL( (acklam[i] - exact) / scale, 1.2e-9 );
+		BOOST_CHECK_SMALL( (normal_inv( u[i], inversion::acklam() ) - exact) / scale, 1.2e-9 );
+
+		// the fast tier computes the lower tail of min(u, 1 - u) in single precision, and is exact up to that rounding
+		const float p = static_cast<float>( std::min(u[i], 1 - u[i]) );
+		if (p < FLT_MIN)
+			continue;
+		const double exact_float = u[i] > 0.5 ? -normal_inv( static_cast<double>(p), inversion::as241() ) 
+			: normal_inv( static_cast<double>(p), inversion::as241() );
+		const double scale_float = std::max( 1.0, std::fabs(exact_float) );
+		BOOST_CHECK_SMALL( (normal_inv( u[i], inversion::fast() ) - exact_float) / scale_float, 5e-7 );
+		BOOST_CHECK_SMALL( (fast[i] - exact_float) / scale_float, 5e-7 );
+	}
+}
+
+//! a generator of a reference to an engine advances it, and otherwise gives the same variates
+BOOST_AUTO_TEST_CASE(engine_reference)
+{
+	BOOST_TEST_MESSAGE("Testing variate_generator with an engine reference ...");
+
+	using qfcl::random::mt19937;
+	using qfcl::random::variate_generator;
+	typedef qfcl::random::normal_inversion_distribution<> distribution;
+
+	mt19937 eng, copy;
+	variate_generator<mt19937, distribution> by_value( copy, distribution() );
+	variate_generator<mt19937 &, distribution> by_reference( eng, distribution() );
+
+	for (int i = 0; i < 1000; ++i)
+		BOOST_REQUIRE_EQUAL( by_value(), by_reference() );
+
+	copy.discard(1000);
+	BOOST_CHECK( eng == copy );
+
+	// a new generator is constructed for each sample, which must advance the engine
+	const qfcl::random::gbm_vanilla_call call(100, 0.2, 0, 0.05, 100, 1);
+	double first = call(eng), same = 1;
+	for (int i = 0; i < 100; ++i)
+		if (call(eng) != first)
+			same = 0;
+	BOOST_CHECK_EQUAL( same, 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
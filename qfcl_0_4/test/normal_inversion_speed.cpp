@@ -0,0 +1,165 @@
+/* test/normal_inversion_speed.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/timer/timer.hpp>
+
+#include <qfcl/random/distribution/normal_inversion.hpp>
+
+const std::string usage = "Usage: normal_inversion_speed [sample_size]\n";
+const std::string description = "Accuracy and throughput of the accuracy tiers of the inverse normal cdf.";
+
+using qfcl::random::detail::normal_inv;
+namespace inversion = qfcl::random::inversion;
+
+//! the inverse normal cdf to nearly full double precision: AS241 followed by a Newton step
+double reference(double p)
+{
+	if (p > 0.5)
+		return -reference(1 - p);
+
+	double x = normal_inv(p, inversion::as241());
+	const double cdf = 0.5 * std::erfc( -x / std::sqrt(2.0) );
+	const double pdf = std::exp(-0.5 * x * x) / std::sqrt(2 * 3.14159265358979323846);
+
+	return x - (cdf - p) / pdf;
+}
+
+//! the probability actually inverted by \p Tier, i.e. \p p rounded to the precision of the computation
+double input(double p, inversion::acklam) {return p;}
+double input(double p, inversion::as241) {return p;}
+double input(double p, inversion::fast) {return static_cast<float>(p);}
+
+//! maximum relative error (absolute error for |x| < 1) of the batch inversion over \p u
+template<typename Tier>
+double max_error(const std::vector<double> & u)
+{
+	std::vector<double> z( u.size() );
+	normal_inv( &u[0], &z[0], u.size(), Tier() );
+
+	double error = 0;
+	for (std::size_t i = 0; i < u.size(); ++i)
+	{
+		const double x = reference( input(u[i], Tier()) );
+		error = std::max( error, std::fabs(z[i] - x) / std::max( 1.0, std::fabs(x) ) );
+	}
+
+	return error;
+}
+
+//! the floating point type the tier is timed with
+template<typename Tier>
+struct working_type
+{
+	typedef double type;
+};
+
+template<>
+struct working_type<inversion::fast>
+{
+	typedef float type;
+};
+
+inline float scalar_inv(float p, inversion::fast) {return qfcl::random::detail::normal_inv_fast(p);}
+template<typename Tier>
+inline double scalar_inv(double p, Tier) {return normal_inv( p, Tier() );}
+
+//! millions of variates per second, for scalar and batch inversion of \p u
+template<typename Tier>
+void throughput(const std::vector<double> & u_, double & scalar, double & batch)
+{
+	using namespace boost::timer;
+	typedef typename working_type<Tier>::type real;
+
+	const std::vector<real> u( u_.begin(), u_.end() );
+	std::vector<real> z( u.size() );
+	volatile real sink;
+
+	cpu_timer t_scalar;
+	for (std::size_t i = 0; i < u.size(); ++i)
+		z[i] = scalar_inv( u[i], Tier() );
+	t_scalar.stop();
+	sink = z[ u.size() / 2 ];
+
+	cpu_timer t_batch;
+	normal_inv( &u[0], &z[0], u.size(), Tier() );
+	t_batch.stop();
+	sink = z[ u.size() / 2 ];
+
+	scalar = u.size() / (t_scalar.elapsed().wall * 1e-3);
+	batch = u.size() / (t_batch.elapsed().wall * 1e-3);
+}
+
+template<typename Tier>
+void print_row(const std::string & name, const std::vector<double> & u, const std::vector<double> & central,
+	const std::vector<double> & tails)
+{
+	double scalar, batch;
+	throughput<Tier>(u, scalar, batch);
+
+	std::cout << std::left << std::setw(10) << name << std::right
+			  << std::setw(14) << std::fixed << std::setprecision(1) << scalar
+			  << std::setw(14) << batch
+			  << std::setw(16) << std::scientific << std::setprecision(2) << max_error<Tier>(central)
+			  << std::setw(16) << max_error<Tier>(tails) << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+	using namespace std;
+
+	size_t sample_size = 10000000;
+	if (argc >= 2)
+		sample_size = boost::lexical_cast<size_t>(argv[1]);
+	else
+		cout << usage << endl << description << endl << endl;
+
+	// uniforms in (0, 1) for timing
+	boost::random::mt19937 eng;
+	vector<double> u(sample_size);
+	for (size_t i = 0; i < sample_size; ++i)
+		u[i] = (eng() + 0.5) / 4294967296.0;
+
+	// a grid of the central region, and log-spaced points in both tails down to p_min
+	vector<double> central;
+	for (int i = 1; i < 100000; ++i)
+		central.push_back(i / 100000.0);
+
+	vector<double> tails, float_tails;
+	for (double p = 1e-300; p < 0.075; p *= 1.01)
+	{
+		tails.push_back(p);
+		if (p >= FLT_MIN)
+			float_tails.push_back(p);
+		if (p > 1e-16)
+			tails.push_back(1 - p);
+		if (p > 1e-7)
+			float_tails.push_back(1 - p);
+	}
+
+	cout << left << setw(10) << "tier" << right << setw(14) << "scalar (M/s)" << setw(14) << "batch (M/s)"
+		 << setw(16) << "error (center)" << setw(16) << "error (tails)" << endl;
+
+	print_row<inversion::fast>("fast", u, central, float_tails);
+	print_row<inversion::acklam>("acklam", u, central, tails);
+	print_row<inversion::as241>("as241", u, central, tails);
+
+	cout << endl << "Errors are relative, or absolute for |z| < 1, for p rounded to the working precision of the tier." << endl
+		 << "The fast tier is timed with float, and its errors are only measured for p >= FLT_MIN." << endl;
+}
@@ -0,0 +1,197 @@
+/* test/parallel_streams.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/random/philox.hpp>
+#include <boost/random/threefry.hpp>
+
+#include <qfcl/random/parallel_streams.hpp>
+#include <qfcl/statistics/summation.hpp>
+#include <qfcl/utility/work_stealing_pool.hpp>
+
+namespace {
+
+const unsigned thread_counts[] = {1, 2, 3, 8};
+
+//! a job of uneven length, summing uniforms in [0, 1)
+struct uneven_job
+{
+	template<class Engine>
+	qfcl::random::monte_carlo_sums<> operator()(boost::uint64_t job, Engine & e) const
+	{
+		const std::size_t n = 100 + 997 * (job % 13);
+		std::vector<double> x(n);
+		for (std::size_t i = 0; i < n; ++i)
+			x[i] = e() * (1.0 / 4294967296.0);
+
+		qfcl::random::monte_carlo_sums<> sums;
+		sums.add(&x[0], n);
+
+		return sums;
+	}
+};
+
+//! bitwise equality, so that different NaNs or signed zeros are not confused
+bool identical(double x, double y)
+{
+	return std::memcmp( &x, &y, sizeof(double) ) == 0;
+}
+
+}	// anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(parallel_streams)
+
+//! pairwise_sum adds along the balanced tree, and compensated_sum recovers what plain summation loses
+BOOST_AUTO_TEST_CASE(summation)
+{
+	BOOST_TEST_MESSAGE("Testing pairwise_sum and compensated_sum ...");
+
+	const std::vector<double> empty;
+	BOOST_CHECK_EQUAL( qfcl::statistics::pairwise_sum( empty.begin(), empty.end() ), 0.0 );
+
+	// ((1e16 + 1) + (1 + 1)) = 1e16 + 2, whereas adding left to right loses each 1
+	std::vector<double> x;
+	x.push_back(1e16); x.push_back(1); x.push_back(1); x.push_back(1);
+	BOOST_CHECK_EQUAL( qfcl::statistics::pairwise_sum( x.begin(), x.end() ), 1e16 + 2 );
+
+	qfcl::statistics::compensated_sum<> s;
+	double naive = 0;
+	for (std::size_t i = 0; i < 1000; ++i)
+	{
+		s += 1e16; s += 1.0; s += -1e16;
+		naive += 1e16; naive += 1.0; naive += -1e16;
+	}
+	BOOST_CHECK_EQUAL( s.value(), 1000.0 );
+	BOOST_CHECK( naive != 1000.0 );
+
+	qfcl::statistics::compensated_sum<> a(1e16), b(1.0);
+	b += 1.0;
+	BOOST_CHECK_EQUAL( (a + b).value(), 1e16 + 2 );
+}
+
+//! every index is run exactly once, for any number of threads
+BOOST_AUTO_TEST_CASE(pool)
+{
+	BOOST_TEST_MESSAGE("Testing work_stealing_pool ...");
+
+	const std::size_t sizes[] = {1, 2, 7, 100, 10007};
+	for (std::size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); ++t)
+	{
+		qfcl::work_stealing_pool pool( thread_counts[t] );
+		BOOST_REQUIRE_EQUAL( pool.size(), thread_counts[t] );
+
+		for (std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+		{
+			std::vector< std::atomic<int> > runs( sizes[k] );
+			for (std::size_t i = 0; i < runs.size(); ++i)
+				runs[i] = 0;
+
+			// the iterations take unequal times, so that the workers steal
+			pool.parallel_for( sizes[k], [&] (std::size_t i) {
+				volatile double x = 0;
+				for (std::size_t j = 0; j < (i % 5) * 1000; ++j)
+					x = x + 1;
+				++runs[i];
+			} );
+
+			for (std::size_t i = 0; i < runs.size(); ++i)
+				BOOST_REQUIRE_EQUAL( runs[i], 1 );
+		}
+
+		pool.parallel_for( 0, [] (std::size_t) {} );
+	}
+}
+
+//! an exception thrown by an iteration is rethrown, and the pool is still usable
+BOOST_AUTO_TEST_CASE(pool_exception)
+{
+	BOOST_TEST_MESSAGE("Testing exceptions in work_stealing_pool ...");
+
+	qfcl::work_stealing_pool pool(4);
+	BOOST_CHECK_THROW( pool.parallel_for( 1000, [] (std::size_t i) {
+		if (i == 517)
+			throw std::runtime_error("iteration 517");
+	} ), std::runtime_error );
+
+	std::atomic<std::size_t> count(0);
+	pool.parallel_for( 1000, [&] (std::size_t) {++count;} );
+	BOOST_CHECK_EQUAL( count, 1000u );
+}
+
+//! the keys hold the seed and the job, in separate halves
+BOOST_AUTO_TEST_CASE(keys)
+{
+	BOOST_TEST_MESSAGE("Testing the keys of counter_based_streams ...");
+
+	typedef qfcl::random::counter_based_streams< boost::random::philox<4, boost::uint32_t> > Philox;
+	typedef qfcl::random::counter_based_streams< boost::random::threefry<4, boost::uint64_t> > Threefry;
+
+	BOOST_CHECK_EQUAL( Philox::max_job(), 0xFFFFFFFFu );
+	BOOST_CHECK_EQUAL( Threefry::max_job(), ~boost::uint64_t(0) );
+	BOOST_CHECK_THROW( Philox(boost::uint64_t(1) << 32), std::out_of_range );
+	BOOST_CHECK_THROW( Philox(7).key(boost::uint64_t(1) << 32), std::out_of_range );
+
+	const Philox::key_type k = Philox(7).key(5);
+	BOOST_CHECK_EQUAL( k[0], 5u );
+	BOOST_CHECK_EQUAL( k[1], 7u );
+
+	const Threefry::key_type k2 = Threefry(0x123456789ull).key(0xabcdef012ull);
+	BOOST_CHECK_EQUAL( k2[0], 0xabcdef012ull );
+	BOOST_CHECK_EQUAL( k2[1], 0u );
+	BOOST_CHECK_EQUAL( k2[2], 0x123456789ull );
+	BOOST_CHECK_EQUAL( k2[3], 0u );
+
+	std::set<Philox::key_type> keys;
+	for (boost::uint64_t seed = 0; seed < 4; ++seed)
+		for (boost::uint64_t job = 0; job < 100; ++job)
+			keys.insert( Philox(seed).key(job) );
+	BOOST_CHECK_EQUAL( keys.size(), 400u );
+}
+
+//! the sum is the same, to the last bit, for any number of threads
+BOOST_AUTO_TEST_CASE(reproducible)
+{
+	BOOST_TEST_MESSAGE("Testing that counter_based_streams::sum does not depend on the threads ...");
+
+	typedef qfcl::random::counter_based_streams< boost::random::philox<4, boost::uint32_t> > Streams;
+	const Streams streams(2012);
+	const std::size_t jobs = 101;
+
+	std::vector< qfcl::random::monte_carlo_sums<> > results;
+	for (std::size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); ++t)
+	{
+		qfcl::work_stealing_pool pool( thread_counts[t] );
+		results.push_back( streams.sum( pool, jobs, uneven_job() ) );
+	}
+
+	BOOST_CHECK_SMALL( results[0].mean() - 0.5, 0.01 );
+	for (std::size_t t = 1; t < results.size(); ++t)
+	{
+		BOOST_CHECK_EQUAL( results[t].count(), results[0].count() );
+		BOOST_CHECK( identical( results[t].mean(), results[0].mean() ) );
+		BOOST_CHECK( identical( results[t].standard_error(), results[0].standard_error() ) );
+	}
+
+	// a different seed gives different streams
+	qfcl::work_stealing_pool pool(2);
+	BOOST_CHECK( !identical( Streams(2013).sum( pool, jobs, uneven_job() ).mean(), results[0].mean() ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
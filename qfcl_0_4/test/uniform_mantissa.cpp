@@ -0,0 +1,219 @@
+/* test/uniform_mantissa.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/mpl/list.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+#include <qfcl/random/buffered_variate_generator.hpp>
+#include <qfcl/random/distribution/uniform_mantissa.hpp>
+#include <qfcl/random/engine/mersenne_twister.hpp>
+
+namespace {
+
+//! an engine that always returns the same number
+template<typename UIntType>
+struct constant_engine
+{
+	typedef UIntType result_type;
+
+	explicit constant_engine(UIntType x_) : x(x_) {}
+
+	result_type operator()() {return x;}
+	static result_type min() {return 0;}
+	static result_type max() {return std::numeric_limits<result_type>::max();}
+
+	UIntType x;
+};
+
+//! the variate of \p Distribution from engine outputs that are all \p x
+template<class Distribution, typename UIntType>
+typename Distribution::result_type constant_variate(UIntType x)
+{
+	const constant_engine<UIntType> eng(x);
+	qfcl::random::variate_generator<constant_engine<UIntType>, Distribution> rng( eng, Distribution() );
+	return rng();
+}
+
+const std::size_t sample_size = 10000;
+
+//! the 32 bit generator with a narrower range
+struct mt19937_31 : boost::random::mt19937
+{
+	typedef boost::random::mt19937::result_type result_type;
+	static result_type min() {return 0;}
+	static result_type max() {return 0x7FFFFFFF;}
+	result_type operator()() {return boost::random::mt19937::operator()() >> 1;}
+};
+
+//! the 32 bit generator with 15 bits per output, as for \c cpp_rand
+struct mt19937_15 : boost::random::mt19937
+{
+	typedef boost::random::mt19937::result_type result_type;
+	static result_type min() {return 0;}
+	static result_type max() {return 0x7FFF;}
+	result_type operator()() {return boost::random::mt19937::operator()() >> 17;}
+};
+
+//! the fraction of the variates of \p Distribution whose lowest mantissa bit is 1
+template<class Engine, class Distribution>
+double lowest_bit_frequency()
+{
+	typedef typename Distribution::result_type RealType;
+	static const int mantissa_bits = std::numeric_limits<RealType>::digits - 1;
+
+	Engine eng;
+	qfcl::random::variate_generator<Engine, Distribution> rng( eng, Distribution() );
+
+	std::size_t odd = 0;
+	for (std::size_t i = 0; i < sample_size; ++i)
+		if ( std::fmod( std::ldexp( static_cast<double>( rng() ), mantissa_bits ), 2.0 ) == 1 )
+			++odd;
+
+	return static_cast<double>(odd) / sample_size;
+}
+
+}	// anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(uniform_mantissa)
+
+typedef boost::mpl::list<float, double> real_types;
+
+//! the endpoints are attained exactly when they are included, and otherwise the extreme values are next to them
+BOOST_AUTO_TEST_CASE_TEMPLATE(endpoints, RealType, real_types)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the endpoints of the mantissa uniform distributions ...");
+
+	const RealType eps = std::numeric_limits<RealType>::epsilon();
+	const boost::uint32_t zero = 0, ones = 0xFFFFFFFFu;
+	const boost::uint64_t zero64 = 0, ones64 = ~zero64;
+
+	BOOST_CHECK_EQUAL( constant_variate< uniform_mantissa_0in_1ex<RealType> >(zero), 0 );
+	BOOST_CHECK_EQUAL( constant_variate< uniform_mantissa_0in_1ex<RealType> >(ones64), 1 - eps );
+	BOOST_CHECK_EQUAL( constant_variate< uniform_mantissa_0ex_1in<RealType> >(zero64), 1 );
+	BOOST_CHECK_EQUAL( constant_variate< uniform_mantissa_0ex_1in<RealType> >(ones), eps );
+	BOOST_CHECK_EQUAL( constant_variate< uniform_mantissa_0ex_1ex<RealType> >(zero), eps / 2 );
+	BOOST_CHECK_EQUAL( constant_variate< uniform_mantissa_0ex_1ex<RealType> >(ones64), 1 - eps / 2 );
+	BOOST_CHECK_EQUAL( constant_variate< uniform_mantissa_0in_1in<RealType> >(zero64), 0 );
+	BOOST_CHECK_EQUAL( constant_variate< uniform_mantissa_0in_1in<RealType> >(ones), 1 );
+}
+
+//! with a 32 bit engine a double has more than 32 random bits
+BOOST_AUTO_TEST_CASE(resolution)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the resolution of uniform_mantissa_0in_1ex<double> ...");
+
+	mt19937 eng;
+	variate_generator<mt19937, uniform_mantissa_0in_1ex<> > rng( eng, uniform_mantissa_0in_1ex<>() );
+
+	std::size_t fine = 0;
+	double sum = 0;
+	for (std::size_t i = 0; i < sample_size; ++i)
+	{
+		const double u = rng();
+		sum += u;
+
+		BOOST_REQUIRE( 0 <= u && u < 1 );
+		// a multiple of 2^-52
+		BOOST_REQUIRE_EQUAL( std::ldexp(u, 52), std::floor( std::ldexp(u, 52) ) );
+		if ( std::ldexp(u, 32) != std::floor( std::ldexp(u, 32) ) )
+			++fine;
+	}
+
+	BOOST_CHECK( fine > sample_size * 0.99 );
+	BOOST_CHECK_CLOSE( sum / sample_size, 0.5, 2.0 );
+}
+
+// engines with 32 and 64 bit outputs, and with and without a bulk generate
+typedef boost::mpl::list<qfcl::random::mt19937, qfcl::random::mt19937_64, boost::random::mt19937> engines;
+
+//! the SIMD batch conversion of the buffered_variate_generator is identical to the scalar one
+template<class Engine, class Distribution>
+void check_batch()
+{
+	Engine eng;
+	qfcl::random::variate_generator<Engine, Distribution> rng( eng, Distribution() );
+	qfcl::random::buffered_variate_generator<Engine, Distribution, 1000> buffered( eng, Distribution() );
+
+	bool same = true;
+	for (std::size_t i = 0; i < sample_size; ++i)
+		same = same && rng() == buffered();
+
+	BOOST_CHECK(same);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(batch, Engine, engines)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the batch mantissa uniform distributions ...");
+
+	check_batch< Engine, uniform_mantissa_0in_1ex<> >();
+	check_batch< Engine, uniform_mantissa_0ex_1in<> >();
+	check_batch< Engine, uniform_mantissa_0ex_1ex<> >();
+	check_batch< Engine, uniform_mantissa_0in_1in<> >();
+	check_batch< Engine, uniform_mantissa_0in_1ex<float> >();
+	check_batch< Engine, uniform_mantissa_0ex_1ex<float> >();
+}
+
+//! an engine with 31 bits per output still fills the whole mantissa of a double
+BOOST_AUTO_TEST_CASE(narrow_engine)
+{
+	using namespace qfcl::random;
+
+	check_batch< mt19937_31, uniform_mantissa_0ex_1ex<> >();
+
+	mt19937_31 eng;
+	variate_generator<mt19937_31, uniform_mantissa_0in_1ex<> > rng( eng, uniform_mantissa_0in_1ex<>() );
+
+	// 62 random bits, of which the highest 52 are used
+	std::size_t odd = 0;
+	for (std::size_t i = 0; i < sample_size; ++i)
+		if ( std::fmod( std::ldexp(rng(), 52), 2.0 ) == 1 )
+			++odd;
+
+	BOOST_CHECK( odd > sample_size / 3 );
+}
+
+//! an engine with 15 bits per output takes 4 outputs for a double and 2 for a float, to fill the whole mantissa
+BOOST_AUTO_TEST_CASE(very_narrow_engine)
+{
+	using namespace qfcl::random;
+
+	BOOST_TEST_MESSAGE("Testing the mantissa uniform distributions with a 15 bit engine ...");
+
+	check_batch< mt19937_15, uniform_mantissa_0in_1ex<> >();
+	check_batch< mt19937_15, uniform_mantissa_0ex_1ex<> >();
+	check_batch< mt19937_15, uniform_mantissa_0in_1ex<float> >();
+
+	BOOST_CHECK_CLOSE( (lowest_bit_frequency< mt19937_15, uniform_mantissa_0in_1ex<> >()), 0.5, 5.0 );
+	BOOST_CHECK_CLOSE( (lowest_bit_frequency< mt19937_15, uniform_mantissa_0in_1ex<float> >()), 0.5, 5.0 );
+
+	// the engine is advanced by 4 outputs per double
+	mt19937_15 eng, copy;
+	variate_generator<mt19937_15 &, uniform_mantissa_0in_1ex<> > rng( eng, uniform_mantissa_0in_1ex<>() );
+	rng();
+	for (int j = 0; j < 4; ++j)
+		copy();
+	BOOST_CHECK( eng() == copy() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
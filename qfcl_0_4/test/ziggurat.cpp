@@ -0,0 +1,124 @@
+/* test/ziggurat.cpp
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * Use, modification and distribution are subject to
+ * the BOOST Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt)
+ */
+
+#include "test_generator.ipp"
+using namespace boost::unit_test_framework;
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+#include <qfcl/random/distribution/exponential_ziggurat.hpp>
+#include <qfcl/random/distribution/normal_ziggurat.hpp>
+
+namespace {
+
+const std::size_t sample_size = 1000000;
+
+//! a sorted sample of \c sample_size variates
+template<class Engine, class Distribution>
+std::vector<double> sorted_sample()
+{
+	Engine eng;
+	Distribution dist;
+	qfcl::random::variate_generator<Engine, Distribution> rng(eng, dist);
+
+	std::vector<double> x(sample_size);
+	for (std::size_t i = 0; i < sample_size; ++i)
+		x[i] = rng();
+	std::sort( x.begin(), x.end() );
+
+	return x;
+}
+
+//! the Kolmogorov-Smirnov statistic, scaled by the square root of the sample size
+template<typename Cdf>
+double ks_statistic(const std::vector<double> & x, Cdf cdf)
+{
+	double d = 0;
+	for (std::size_t i = 0; i < x.size(); ++i)
+	{
+		const double F = cdf(x[i]);
+		d = std::max( d, std::max( F - double(i) / x.size(), double(i + 1) / x.size() - F ) );
+	}
+
+	return d * std::sqrt( double( x.size() ) );
+}
+
+double normal_cdf(double x) {return 0.5 * std::erfc( -x / std::sqrt(2.0) );}
+double exponential_cdf(double x) {return 1 - std::exp(-x);}
+
+double mean(const std::vector<double> & x)
+{
+	double sum = 0;
+	for (std::size_t i = 0; i < x.size(); ++i)
+		sum += x[i];
+
+	return sum / x.size();
+}
+
+double variance(const std::vector<double> & x)
+{
+	const double m = mean(x);
+	double sum = 0;
+	for (std::size_t i = 0; i < x.size(); ++i)
+		sum += (x[i] - m) * (x[i] - m);
+
+	return sum / x.size();
+}
+
+// 32 bit, 64 bit and 31 bit (the 32 bit generator with a narrower range) engines
+struct mt19937_31 : boost::random::mt19937
+{
+	typedef boost::random::mt19937::result_type result_type;
+	static result_type min() {return 0;}
+	static result_type max() {return 0x7FFFFFFF;}
+	result_type operator()() {return boost::random::mt19937::operator()() >> 1;}
+};
+
+typedef boost::mpl::list<boost::random::mt19937, boost::random::mt19937_64, mt19937_31> engines;
+
+}	// anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(ziggurat)
+
+// The critical value of the scaled KS statistic is 1.95 at the 0.1% level.
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(normal, Engine, engines)
+{
+	BOOST_TEST_MESSAGE("Testing normal_ziggurat ...");
+
+	const std::vector<double> x = sorted_sample< Engine, qfcl::random::normal_ziggurat<> >();
+	BOOST_CHECK_SMALL( mean(x), 0.005 );
+	BOOST_CHECK_CLOSE( variance(x), 1.0, 0.5 );
+	BOOST_CHECK_LT( ks_statistic(x, normal_cdf), 1.95 );
+
+	const std::vector<double> y = sorted_sample< Engine, qfcl::random::normal_ziggurat<float> >();
+	BOOST_CHECK_LT( ks_statistic(y, normal_cdf), 1.95 );
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(exponential, Engine, engines)
+{
+	BOOST_TEST_MESSAGE("Testing exponential_ziggurat ...");
+
+	const std::vector<double> x = sorted_sample< Engine, qfcl::random::exponential_ziggurat<> >();
+	BOOST_CHECK_GE( x.front(), 0.0 );
+	BOOST_CHECK_CLOSE( mean(x), 1.0, 0.5 );
+	BOOST_CHECK_CLOSE( variance(x), 1.0, 1.0 );
+	BOOST_CHECK_LT( ks_statistic(x, exponential_cdf), 1.95 );
+
+	const std::vector<double> y = sorted_sample< Engine, qfcl::random::exponential_ziggurat<float> >();
+	BOOST_CHECK_LT( ks_statistic(y, exponential_cdf), 1.95 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()